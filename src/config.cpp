@@ -56,7 +56,7 @@ struct Parser
         GAP,
 
         SPINE_MIN, SPINE_MAX, BATCH_SIZE,
-        BENCHMARK_BFS, BENCHMARK_DFS, BENCHMARK_DYNAMIC,
+        BENCHMARK_BFS, BENCHMARK_DFS, BENCHMARK_DYNAMIC, THREADS,
 
         LOG_LEVEL, LOG_MODE, LOG_FILE,
 
@@ -89,6 +89,7 @@ struct Parser
         if ("--benchmark-bfs"s == opt)                 return Token::BENCHMARK_BFS;
         if ("--benchmark-dfs"s == opt)                 return Token::BENCHMARK_DFS;
         if ("--benchmark-dynamic"s == opt)             return Token::BENCHMARK_DYNAMIC;
+        if ("--threads"s == opt)                       return Token::THREADS;
 
         if ("-v"s == opt || "--log-level"s == opt)     return Token::LOG_LEVEL;
         if ("--log-mode"s == opt)                      return Token::LOG_MODE;
@@ -129,6 +130,7 @@ struct Parser
 
         if ("degrees"s == opt)  return Configuration::InputFormat::DEGREES;
         if ("edgelist"s == opt) return Configuration::InputFormat::EDGELIST;
+        if ("binary"s == opt)   return Configuration::InputFormat::BINARY;
 
         throw ConfigException("Unknown input format: "s += opt);
     }
@@ -324,6 +326,7 @@ void Configuration::readArgv(int argc, const char* argv[])
         case Parser::Token::BENCHMARK_BFS:     benchmarkBfs = parser.boolArg(); break;
         case Parser::Token::BENCHMARK_DFS:     benchmarkDfs = parser.boolArg(); break;
         case Parser::Token::BENCHMARK_DYNAMIC: benchmarkDynamic = parser.boolArg(); break;
+        case Parser::Token::THREADS:         threads = parser.intArg(); break;
 
         case Parser::Token::LOG_LEVEL:       logLevel = parser.logLevel(); break;
         case Parser::Token::LOG_MODE:        logMode = parser.logMode(); break;
@@ -352,6 +355,9 @@ void Configuration::validate() const
     if (Algorithm::BENCHMARK == algorithm && !benchmarkDynamic && (!archiveYes.empty() || !archiveNo.empty()))
         throw ConfigException("Benchmark archive requires dynamic algorithm.");
 
+    if (Algorithm::BENCHMARK == algorithm && threads > 1 && !outputFile.empty())
+        throw ConfigException("Benchmark with multiple threads does not support SVG output.");
+
     if (Algorithm::BENCHMARK != algorithm && inputFile.empty())
         throw ConfigException("Please specify an input file.");
 
@@ -435,6 +441,7 @@ void Configuration::dump() const
         theLog->writeRaw(LogLevel::INFO, "\tBenchmark heuristic with BFS order: {}{}\n", std::boolalpha, benchmarkBfs);
         theLog->writeRaw(LogLevel::INFO, "\tBenchmark heuristic with DFS order: {}{}\n", std::boolalpha, benchmarkDfs);
         theLog->writeRaw(LogLevel::INFO, "\tBenchmark dynamic program: {}{}\n", std::boolalpha, benchmarkDynamic);
+        theLog->writeRaw(LogLevel::INFO, "\tThreads: {}\n", threads);
     }
     if (Algorithm::KLEMZ_NOELLENBURG_PRUTKIN == algorithm) {
         theLog->writeRaw(LogLevel::INFO, "\tGap: {}{}\n\n", std::setprecision(3), gap);
@@ -473,6 +480,7 @@ const char* Configuration::inputFormatString(InputFormat inputFormat) noexcept
     switch (inputFormat) {
     case InputFormat::DEGREES: return "degrees";
     case InputFormat::EDGELIST: return "edgelist";
+    case InputFormat::BINARY: return "binary";
     default: assert(0); return "?";
     }
 }
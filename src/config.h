@@ -29,7 +29,7 @@ public:
     /**
      * Enumeration of available file formats for input files.
      */
-    enum class InputFormat { DEGREES, EDGELIST };
+    enum class InputFormat { DEGREES, EDGELIST, BINARY };
 
     /**
      * Enumeration of available file formats for output files.
@@ -75,6 +75,7 @@ public:
     bool benchmarkBfs = true;
     bool benchmarkDfs = true;
     bool benchmarkDynamic = true;
+    int threads = 1; //!< number of worker threads in benchmark mode
 
     LogLevel logLevel = LogLevel::INFO;
     LogMode logMode = LogMode::DEFAULT;
@@ -3,6 +3,11 @@
 #include "utility/log.h"
 #include "utility/exception.h"
 #include <algorithm>
+#include <bit>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
 
 Fundament::Fundament() noexcept = default;
 
@@ -15,7 +20,7 @@ Fundament::Fundament(const Grid& grid, Coord spineHead) noexcept
 			Coord c{ spineHead.x + x, spineHead.sly + sly };
 			bool blocked = grid.at(c) != nullptr;
 			int n = index({ x,sly });
-			mask.set(n, blocked);
+			mask |= std::uint32_t{ blocked } << n;
 		}
 	}
 }
@@ -44,12 +49,12 @@ Coord Fundament::at(int bit)
 
 bool Fundament::blocked(Coord c) const noexcept
 {
-	return mask.test(index(c));
+	return (mask >> index(c)) & 1;
 }
 
 void Fundament::block(Coord c) noexcept
 {
-	mask.set(index(c));
+	mask |= 1u << index(c);
 }
 
 void Fundament::shift(Dir dir) noexcept
@@ -63,11 +68,11 @@ void Fundament::shift(Dir dir) noexcept
 		break;
 
 	case Dir::RIGHT:
-		(mask >>= 6) &= 0b01111'01111'01111'01111'01111;
+		mask = (mask >> 6) & ~RIGHTMOST;
 		break;
 
 	case Dir::RIGHT_DOWN:
-		(mask >>= 1) &= 0b01111'01111'01111'01111'01111;
+		mask = (mask >> 1) & ~RIGHTMOST;
 		break;
 
 	}
@@ -75,49 +80,31 @@ void Fundament::shift(Dir dir) noexcept
 
 Fundament Fundament::reachable(Coord from, int steps) const noexcept
 {
-	Fundament result;
-	result.mask.set(); // block everything
-	result.mask.set(index(from), false);
-
-	Coord near[] = { { -1, 0 }, { -1, 1 }, {0, 1}, {1, 0}, {1, -1}, {0, -1} };
-	Coord next[6];
-
-	for (int step = 0; step < steps; step++) {
-		Fundament mid = result;
-
-		for (int bit = 0; bit < 25; bit++) {
-			if (!result.mask.test(bit)) {
-				// expand 1 step from here
-				Coord e = at(bit);
-				std::transform(near, near + 6, next,
-					[e](Coord n) { return Coord{ e.x + n.x, e.sly + n.sly }; });
-
-				for (Coord n : next) {
-					if (index(n) != -1 && !blocked(n))
-						mid.mask.set(index(n), false);
-				}
-			}
-		}
+	std::uint32_t start = 1u << index(from);
+	std::uint32_t free = ~mask & ALL;
+	std::uint32_t reached = start;
 
-		result = mid;
-	}
+	for (int step = 0; step < steps; step++)
+		reached |= grow(reached) & free;
 
-	result.mask.set(index(from), true); // from is always blocked
+	Fundament result;
+	result.mask = ~(reached & ~start) & ALL; // from is always blocked
 	return result;
 }
 
 Fundament Fundament::reachableBySpine(Coord from) const noexcept
 {
-	Fundament result;
-	result.mask.set(); // block everything
+	std::uint32_t free = ~mask & ALL;
 
-	Coord tos[] = { {from.x, from.sly + 1}, { from.x + 1, from.sly }, { from.x + 1, from.sly - 1 } };
-	for (Coord to : tos) {
-		int bit = index(to);
-		if (bit >= 0 && !mask.test(bit))
-			result.mask.set(bit, false);
-	}
+	Fundament result;
+	result.mask = ~(SPINE_NEIGHBORS[index(from)] & free) & ALL;
+	return result;
+}
 
+Fundament Fundament::mirrored() const noexcept
+{
+	Fundament result;
+	result.mask = transpose(mask);
 	return result;
 }
 
@@ -132,7 +119,7 @@ void Fundament::print() const
 
 		for (int x = -2; x < 2 - sly; x++) {
 			int n = (sly + x + 2) * 5 + (x + 2);
-			std::cout << (mask.test(n) ? "O " : "- ");
+			std::cout << ((mask >> n) & 1 ? "O " : "- ");
 		}
 
 		std::cout << "\n";
@@ -144,7 +131,7 @@ void Fundament::print() const
 
 		for (int x = -2-sly; x < 2; x++) {
 			int n = (sly + x + 2) * 5 + (x + 2);
-			std::cout << (mask.test(n) ? "O " : "- ");
+			std::cout << ((mask >> n) & 1 ? "O " : "- ");
 		}
 
 		std::cout << "\n";
@@ -161,69 +148,90 @@ bool Signature::dominates(const Signature& rhs) const noexcept
 	return (fundament.mask & rhs.fundament.mask) == fundament.mask;
 }
 
-DynamicProblem::DynamicProblem(DiskGraph& graph, bool constructive)
+SolutionTree::SolutionTree(DiskGraph& graph)
+	: graph_(&graph)
+{
+}
+
+int SolutionTree::add(int parent, Coord placement, const Disk& disk)
+{
+	assert(parent < static_cast<int>(nodes_.size()));
+
+	int index = static_cast<int>(&disk - graph_->disks().data());
+	assert(index >= 0 && index < static_cast<int>(graph_->size()));
+
+	nodes_.push_back({ placement, parent, index });
+	return static_cast<int>(nodes_.size()) - 1;
+}
+
+Grid SolutionTree::solution(int node) const
+{
+	Grid solution(graph_->size());
+
+	for (int n = node; ROOT != n; n = nodes_[n].parent)
+		solution.put(nodes_[n].placement, graph_->disks()[nodes_[n].disk]);
+
+	return solution;
+}
+
+std::size_t SolutionTree::size() const noexcept
+{
+	return nodes_.size();
+}
+
+DynamicProblem::DynamicProblem(DiskGraph& graph, SolutionTree* tree)
 	: spineHead_({ -1, 0 }), // this causes first disk at {0, 0}
 	position_(graph.traversal(Configuration::EmbedOrder::DEPTH_FIRST)),
 	end_(graph.end()),
 	depth_(0),
-	constructive_(constructive)
+	tree_(tree),
+	node_(SolutionTree::ROOT)
 {
 }
 
-DynamicProblem::DynamicProblem(std::shared_ptr<const DynamicProblem> parent, Dir dir)
-	: fundament_(parent->fundament_),
-	spineHead_(parent->spineHead_),
-	branchHead_(parent->branchHead_),
-	position_(parent->position_),
-	end_(parent->end_),
-	depth_(parent->depth_ + 1),
-	constructive_(true),
-	parent_(move(parent)) // init last, do not invalidate ptr early
+DynamicProblem::DynamicProblem(const DynamicProblem& parent, Dir dir)
+	: fundament_(parent.fundament_),
+	spineHead_(parent.spineHead_),
+	branchHead_(parent.branchHead_),
+	position_(parent.position_),
+	end_(parent.end_),
+	depth_(parent.depth_ + 1),
+	tree_(parent.tree_),
+	node_(parent.node_)
 {
-	assert(parent_->constructive_); // otherwise we would use the other c'tor
+	Coord placement = initPlacement(dir);
 
-	initPlacement(dir);
-	++position_;
-}
+	if (tree_)
+		node_ = tree_->add(parent.node_, placement, *position_);
 
-DynamicProblem::DynamicProblem(const DynamicProblem* parent, Dir dir)
-	: fundament_(parent->fundament_),
-	spineHead_(parent->spineHead_),
-	branchHead_(parent->branchHead_),
-	position_(parent->position_),
-	end_(parent->end_),
-	depth_(parent->depth_ + 1),
-	constructive_(false)
-{
-	assert(!parent->constructive_); // otherwise we would use the other c'tor
-
-	initPlacement(dir);
 	++position_;
 }
 
-void DynamicProblem::initPlacement(Dir dir)
+Coord DynamicProblem::initPlacement(Dir dir)
 {
+	Coord placement;
+
 	switch (position_->depth) {
 	case 0: // spine
-		placement_ = spineHead_ + dir;
+		placement = spineHead_ + dir;
 		fundament_.shift(dir);
 		fundament_.block({ 0, 0 });
-		spineHead_ = placement_;
+		spineHead_ = placement;
 		break;
 
 	case 1: // branch
 	{
-		placement_ = spineHead_ + dir;
-		Coord relCoord{ placement_.x - spineHead_.x, placement_.sly - spineHead_.sly };
+		placement = spineHead_ + dir;
+		Coord relCoord{ placement.x - spineHead_.x, placement.sly - spineHead_.sly };
 		fundament_.block(relCoord);
-		branchHead_ = placement_;
+		branchHead_ = placement;
 		break;
 	}
 
 	case 2: // leaf
 	{
-		placement_ = branchHead_ + dir;
-		Coord relCoord{ placement_.x - spineHead_.x, placement_.sly - spineHead_.sly };
+		placement = branchHead_ + dir;
+		Coord relCoord{ placement.x - spineHead_.x, placement.sly - spineHead_.sly };
 		fundament_.block(relCoord);
 		break;
 	}
@@ -232,6 +240,8 @@ void DynamicProblem::initPlacement(Dir dir)
 		throw EmbedException("Dynamic program can not embed graphs deeper than lobsters");
 
 	}
+
+	return placement;
 }
 
 std::vector<DynamicProblem> DynamicProblem::subproblems() const
@@ -240,16 +250,7 @@ std::vector<DynamicProblem> DynamicProblem::subproblems() const
 
 	if (0 == depth_) { // special case
 		// arbitrarily choose dir to place the first disk at (0,0)
-
-		if (constructive_) {
-			// build and include information to reconstruct the solution
-			auto sharedThis = std::make_shared<const DynamicProblem>(*this);
-			return { DynamicProblem(move(sharedThis), Dir::RIGHT) };
-		}
-		else {
-			// do not maintain solution information for decision procedure
-			return { DynamicProblem(this, Dir::RIGHT) };
-		}
+		return { DynamicProblem(*this, Dir::RIGHT) };
 	}
 
 	// place disk next to the appropriate head
@@ -281,24 +282,11 @@ std::vector<DynamicProblem> DynamicProblem::subproblems() const
 		return fundament_.blocked({ c.x - spineHead_.x, c.sly - spineHead_.sly });
 	});
 
-	if (begin == end)
-		return {}; // skip constructing shared this
-
 	std::vector<DynamicProblem> subproblems;
+	subproblems.reserve(end - begin);
 
-	if (constructive_) {
-		// build and include information to reconstruct the solution
-		auto sharedThis = std::make_shared<const DynamicProblem>(*this);
-
-		for (auto it = begin; it != end; ++it) {
-			subproblems.push_back({ sharedThis, *it });
-		}
-	}
-	else {
-		// do not maintain solution information for decision procedure
-		for (auto it = begin; it != end; ++it) {
-			subproblems.push_back({ this, *it });
-		}
+	for (auto it = begin; it != end; ++it) {
+		subproblems.push_back({ *this, *it });
 	}
 
 	return subproblems;
@@ -320,12 +308,9 @@ const Fundament& DynamicProblem::fundament() const noexcept
 
 Grid DynamicProblem::solution() const
 {
-	Grid solution(depth_);
-
-	for (auto* prob = this; prob->parent_; prob = prob->parent_.get())
-		solution.put(prob->placement_, *prob->parent_->position_);
+	assert(tree_); // only constructive problems know their solution
 
-	return solution;
+	return tree_->solution(node_);
 }
 
 Coord DynamicProblem::spineHead() const noexcept
@@ -343,69 +328,256 @@ int DynamicProblem::depth() const noexcept
 	return depth_;
 }
 
+GraphTraversal DynamicProblem::position() const noexcept
+{
+	return position_;
+}
+
+namespace
+{
+#if defined(__AVX2__)
+	/**
+	 * Eight cell sets which are processed in parallel.
+	 */
+	struct Lanes
+	{
+		static constexpr std::size_t WIDTH = 8;
+		__m256i v;
+
+		static Lanes load(const std::uint32_t* p) noexcept { return { _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)) }; }
+		static Lanes fill(std::uint32_t x) noexcept { return { _mm256_set1_epi32(static_cast<int>(x)) }; }
+		void store(std::uint32_t* p) const noexcept { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+		Lanes operator&(Lanes rhs) const noexcept { return { _mm256_and_si256(v, rhs.v) }; }
+		Lanes operator|(Lanes rhs) const noexcept { return { _mm256_or_si256(v, rhs.v) }; }
+		Lanes operator^(Lanes rhs) const noexcept { return { _mm256_xor_si256(v, rhs.v) }; }
+		Lanes andNot(Lanes rhs) const noexcept { return { _mm256_andnot_si256(rhs.v, v) }; }
+		template<int N> Lanes shl() const noexcept { return { _mm256_slli_epi32(v, N) }; }
+		template<int N> Lanes shr() const noexcept { return { _mm256_srli_epi32(v, N) }; }
+		bool any() const noexcept { return !_mm256_testz_si256(v, v); }
+	};
+#elif defined(__SSE2__)
+	/**
+	 * Four cell sets which are processed in parallel.
+	 */
+	struct Lanes
+	{
+		static constexpr std::size_t WIDTH = 4;
+		__m128i v;
+
+		static Lanes load(const std::uint32_t* p) noexcept { return { _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)) }; }
+		static Lanes fill(std::uint32_t x) noexcept { return { _mm_set1_epi32(static_cast<int>(x)) }; }
+		void store(std::uint32_t* p) const noexcept { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+		Lanes operator&(Lanes rhs) const noexcept { return { _mm_and_si128(v, rhs.v) }; }
+		Lanes operator|(Lanes rhs) const noexcept { return { _mm_or_si128(v, rhs.v) }; }
+		Lanes operator^(Lanes rhs) const noexcept { return { _mm_xor_si128(v, rhs.v) }; }
+		Lanes andNot(Lanes rhs) const noexcept { return { _mm_andnot_si128(rhs.v, v) }; }
+		template<int N> Lanes shl() const noexcept { return { _mm_slli_epi32(v, N) }; }
+		template<int N> Lanes shr() const noexcept { return { _mm_srli_epi32(v, N) }; }
+		bool any() const noexcept { return 0xffff != _mm_movemask_epi8(_mm_cmpeq_epi32(v, _mm_setzero_si128())); }
+	};
+#else
+	/**
+	 * Scalar fallback: one cell set at a time.
+	 */
+	struct Lanes
+	{
+		static constexpr std::size_t WIDTH = 1;
+		std::uint32_t v;
+
+		static Lanes load(const std::uint32_t* p) noexcept { return { *p }; }
+		static Lanes fill(std::uint32_t x) noexcept { return { x }; }
+		void store(std::uint32_t* p) const noexcept { *p = v; }
+		Lanes operator&(Lanes rhs) const noexcept { return { v & rhs.v }; }
+		Lanes operator|(Lanes rhs) const noexcept { return { v | rhs.v }; }
+		Lanes operator^(Lanes rhs) const noexcept { return { v ^ rhs.v }; }
+		Lanes andNot(Lanes rhs) const noexcept { return { v & ~rhs.v }; }
+		template<int N> Lanes shl() const noexcept { return { v << N }; }
+		template<int N> Lanes shr() const noexcept { return { v >> N }; }
+		bool any() const noexcept { return 0 != v; }
+	};
+#endif
+
+	// Lane-wise equivalents of the Fundament cell set helpers.
+
+	Lanes grow(Lanes cells) noexcept
+	{
+		Lanes left = cells.andNot(Lanes::fill(Fundament::LEFTMOST));
+		Lanes right = cells.andNot(Lanes::fill(Fundament::RIGHTMOST));
+		return (cells | cells.shl<5>() | cells.shr<5>() | right.shl<1>() | right.shl<6>() |
+			left.shr<1>() | left.shr<6>()) & Lanes::fill(Fundament::ALL);
+	}
+
+	Lanes spineStep(Lanes cells) noexcept
+	{
+		Lanes right = cells.andNot(Lanes::fill(Fundament::RIGHTMOST));
+		return (cells.shl<5>() | right.shl<6>() | right.shl<1>()) & Lanes::fill(Fundament::ALL);
+	}
+
+	template<int Shift>
+	Lanes deltaSwap(Lanes cells, std::uint32_t mask) noexcept
+	{
+		Lanes t = (cells ^ cells.shr<Shift>()) & Lanes::fill(mask);
+		return cells ^ t ^ t.shl<Shift>();
+	}
+
+	Lanes transpose(Lanes cells) noexcept
+	{
+		cells = deltaSwap<4>(cells, 0x0082082);
+		cells = deltaSwap<8>(cells, 0x0004104);
+		cells = deltaSwap<12>(cells, 0x0000208);
+		return deltaSwap<16>(cells, 0x0000010);
+	}
+
+	constexpr std::size_t BATCH = 8; //!< number of problems in one signature batch, multiple of Lanes::WIDTH
+
+	/**
+	 * Determine the normalized fundaments of a batch of problems.
+	 *
+	 * On input, @c masks contains the blocked cells and @c leafReach the free
+	 * cells reachable by leaves of each problem. On output, @c masks contains
+	 * the fundament with all unreachable cells blocked and @c mirrors contains
+	 * its mirror image.
+	 */
+	void reachBatch(std::uint32_t* masks, const std::uint32_t* leafReach, std::uint32_t* mirrors,
+		const ReachSchedule& schedule) noexcept
+	{
+		const Lanes all = Lanes::fill(Fundament::ALL);
+
+		for (std::size_t i = 0; i < BATCH; i += Lanes::WIDTH) {
+			Lanes free = all.andNot(Lanes::load(masks + i));
+			Lanes extReach = Lanes::load(leafReach + i);
+			Lanes spinePlaces = Lanes::fill(1u << Fundament::index({ 0, 0 }));
+
+			for (int s = 0; s < schedule.spines && spinePlaces.any(); s++) {
+				Lanes reached = spinePlaces;
+				for (int step = 0; step < schedule.reach[s]; step++)
+					reached = reached | (grow(reached) & free);
+
+				extReach = extReach | reached.andNot(spinePlaces);
+				spinePlaces = spineStep(spinePlaces) & free;
+				extReach = extReach | spinePlaces;
+			}
+
+			Lanes mask = all.andNot(extReach);
+			mask.store(masks + i);
+			transpose(mask).store(mirrors + i);
+		}
+	}
+
+	/**
+	 * Construct the signature from the reachable fundament and its mirror image.
+	 *
+	 * The lesser fundament, viewed as integer, is the normal one.
+	 */
+	Signature normalSignature(int depth, std::uint32_t mask, std::uint32_t mirrored, Coord head) noexcept
+	{
+		Fundament fundament;
+
+		if (mirrored < mask) {
+			fundament.mask = mirrored;
+			head.x += head.sly;
+			head.sly = -head.sly;
+		}
+		else {
+			fundament.mask = mask;
+		}
+
+		return Signature{ depth, fundament, head };
+	}
+}
+
 Signature DynamicProblem::signature() const noexcept
 {
-	Coord head{ 0, 0 };
+	ReachSchedule schedule = ReachSchedule::of(position_, end_);
 
 	// consider branch head only if it is relevant at this point (upcoming leaf)
-	Disk* upcomingDisk = position_ != end_ ? &*position_ : nullptr;
-	if (upcomingDisk != nullptr && 2 == upcomingDisk->depth) {
+	Coord head{ 0, 0 };
+	if (schedule.leaf) {
 		head = { branchHead_.x - spineHead_.x, branchHead_.sly - spineHead_.sly };
 	}
 
 	// disregard unreachable spaces
-	Fundament fundament = reachableEventually(fundament_, head, position_, end_);
+	Fundament fundament = reachableEventually(fundament_, head, schedule);
 
 	// derive transformed alternative from fundament by mirroring, choose one.
-	std::bitset<25> mirrored = fundament.mask;
+	return normalSignature(depth_, fundament.mask, fundament.mirrored().mask, head);
+}
+
+namespace
+{
+	/**
+	 * Append the signatures of sibling problems, given by their blocked cells
+	 * and local branch heads, to the @c result.
+	 */
+	void batchSignatures(const std::uint32_t* masks, const Coord* heads, std::size_t count, int depth,
+		const ReachSchedule& schedule, std::vector<Signature>& result)
+	{
+		for (std::size_t begin = 0; begin < count; begin += BATCH) {
+			std::size_t n = std::min(BATCH, count - begin);
+			std::array<std::uint32_t, BATCH> batch{};
+			std::array<std::uint32_t, BATCH> leafReach{};
+			std::array<std::uint32_t, BATCH> mirrors{};
 
-	for (int x = 0; x < 4; x++) {
-		for (int y = 0; y < 4 - x; y++) {
-			int upper = 5 + x * 6 + y * 5;
-			int lower = 1 + x * 6 + y;
+			for (std::size_t i = 0; i < n; i++) {
+				batch[i] = masks[begin + i];
 
-			// swap one bit
-			bool temp = mirrored[upper];
-			mirrored[upper] = mirrored[lower];
-			mirrored[lower] = temp;
+				if (schedule.leaf)
+					leafReach[i] = Fundament::NEIGHBORS[Fundament::index(heads[begin + i])] & ~batch[i];
+			}
+
+			reachBatch(batch.data(), leafReach.data(), mirrors.data(), schedule);
+
+			for (std::size_t i = 0; i < n; i++)
+				result.push_back(normalSignature(depth, batch[i], mirrors[i], heads[begin + i]));
 		}
 	}
+}
+
+std::vector<Signature> DynamicProblem::signatures(const std::vector<DynamicProblem>& problems)
+{
+	std::vector<Signature> result;
+
+	if (problems.empty())
+		return result;
+
+	// siblings share the upcoming input
+	ReachSchedule schedule = ReachSchedule::of(problems[0].position_, problems[0].end_);
+	std::vector<std::uint32_t> masks;
+	std::vector<Coord> heads;
+	masks.reserve(problems.size());
+	heads.reserve(problems.size());
+
+	for (const DynamicProblem& problem : problems) {
+		assert(problem.position_ == problems[0].position_);
+
+		masks.push_back(problem.fundament_.mask);
 
-	// the lesser fundament, viewed as ulong, is the normal one
-	if (mirrored.to_ulong() < fundament.mask.to_ulong()) {
-		fundament.mask = mirrored;
-		head.x += head.sly;
-		head.sly = -head.sly;
+		if (schedule.leaf)
+			heads.push_back({ problem.branchHead_.x - problem.spineHead_.x, problem.branchHead_.sly - problem.spineHead_.sly });
+		else
+			heads.push_back({ 0, 0 });
 	}
 
-	return Signature{ depth_, fundament, head };
+	result.reserve(problems.size());
+	batchSignatures(masks.data(), heads.data(), problems.size(), problems[0].depth_, schedule, result);
+	return result;
 }
 
-
-Fundament reachableEventually(Fundament base, Coord head, GraphTraversal position, GraphTraversal end) noexcept
+ReachSchedule ReachSchedule::of(GraphTraversal position, GraphTraversal end) noexcept
 {
-	// spaces reachable by placing leaves next to the branch head
-	Fundament leafReach;
+	ReachSchedule schedule{ false, 0, {} };
+
 	if (position != end && 2 == position->depth) {
-		leafReach = base.reachable(head, 1);
+		schedule.leaf = true;
 
 		// advance to next non-leaf
 		while (position != end && 2 <= position->depth)
 			++position;
 	}
-	else {
-		leafReach.mask.set(); // nothing reachable by leaves on branch head
-	}
 
-	// spaces reachable by placing spines and their descendants
-	Fundament extReach;
-	extReach.mask.set();
-
-	// candidate spaces for the next spine
-	Fundament spinePlaces;
-	spinePlaces.mask = 0x1ffeffful; // unblocked center = spine head
-
-	while (position != end && !spinePlaces.mask.all()) {
+	// Every spine step moves at least one row or column further from the
+	// start in the fundament, so we do not need to look further ahead.
+	while (position != end && schedule.spines < MAX_SPINES) {
 		// determine reach = max depth of nodes on current spine
 		int reach = 0;
 		while (position != end && 0 != position->depth) {
@@ -415,106 +587,311 @@ Fundament reachableEventually(Fundament base, Coord head, GraphTraversal positio
 			++position;
 		}
 
-		// unblock all within reach from all candidate spine locations
-		for (int bit = 0; bit < 25; bit++) {
-			if (!spinePlaces.mask.test(bit)) {
-				extReach.mask &= base.reachable(Fundament::at(bit), reach).mask;
-			}
-		}
+		schedule.reach[schedule.spines++] = reach;
 
-		// determine all successor candidate spine locations
-		Fundament nextSpinePlaces;
-		nextSpinePlaces.mask.set(); // block all
+		if (position != end)
+			++position; // advance from previous spine
+	}
 
-		for (int bit = 0; bit < 25; bit++) {
-			if (!spinePlaces.mask.test(bit)) {
-				nextSpinePlaces.mask &= base.reachableBySpine(Fundament::at(bit)).mask;
-			}
-		}
+	return schedule;
+}
+
+Fundament reachableEventually(Fundament base, Coord head, GraphTraversal position, GraphTraversal end) noexcept
+{
+	return reachableEventually(base, head, ReachSchedule::of(position, end));
+}
 
-		extReach.mask &= nextSpinePlaces.mask; // unblock locations reachable by spine alone
-		spinePlaces = nextSpinePlaces;
+Fundament reachableEventually(Fundament base, Coord head, const ReachSchedule& schedule) noexcept
+{
+	const std::uint32_t free = ~base.mask & Fundament::ALL;
 
-		if (position != end)
-			++position; // advance from previous spine
+	// spaces reachable by placing leaves next to the branch head
+	std::uint32_t leafReach = 0;
+	if (schedule.leaf)
+		leafReach = Fundament::NEIGHBORS[Fundament::index(head)] & free;
+
+	// spaces reachable by placing spines and their descendants
+	std::uint32_t extReach = 0;
+
+	// candidate spaces for the next spine
+	std::uint32_t spinePlaces = 1u << Fundament::index({ 0, 0 }); // spine head
+
+	for (int s = 0; s < schedule.spines && 0 != spinePlaces; s++) {
+		// everything within reach from any candidate spine location
+		std::uint32_t reached = spinePlaces;
+		for (int step = 0; step < schedule.reach[s]; step++)
+			reached |= Fundament::grow(reached) & free;
+
+		// The candidates themselves are already free or, at the spine head, blocked.
+		extReach |= reached & ~spinePlaces;
+
+		// determine all successor candidate spine locations
+		spinePlaces = Fundament::spineStep(spinePlaces) & free;
+		extReach |= spinePlaces; // locations reachable by spine alone
 	}
 
 	Fundament result;
-	result.mask = leafReach.mask & extReach.mask;
+	result.mask = ~(leafReach | extReach) & Fundament::ALL;
 	return result;
 }
 
 
+DepthSequence::DepthSequence(DiskGraph& graph)
+{
+	depths_.reserve(graph.size());
+	schedules_.reserve(graph.size() + 1);
+
+	const auto end = graph.end();
+	for (auto it = graph.traversal(Configuration::EmbedOrder::DEPTH_FIRST); it != end; ++it) {
+		if (it->depth > 2)
+			throw EmbedException("Dynamic program can not embed graphs deeper than lobsters");
+
+		depths_.push_back(static_cast<std::int8_t>(it->depth));
+		schedules_.push_back(ReachSchedule::of(it, end));
+	}
+
+	schedules_.push_back(ReachSchedule::of(end, end));
+}
+
+int DepthSequence::size() const noexcept
+{
+	return static_cast<int>(depths_.size());
+}
+
+int DepthSequence::depth(int index) const noexcept
+{
+	return depths_[index];
+}
+
+const ReachSchedule& DepthSequence::schedule(int index) const noexcept
+{
+	return schedules_[index];
+}
+
+namespace
+{
+	const std::int8_t CENTER = static_cast<std::int8_t>(Fundament::index({ 0, 0 }));
+}
+
+static_assert(sizeof(DecisionProblem) <= 12, "DecisionProblem should stay compact");
+
+DecisionProblem::DecisionProblem() noexcept
+	: DecisionProblem(Fundament{}, 0, CENTER)
+{
+}
+
+DecisionProblem::DecisionProblem(Fundament fundament, int depth, std::int8_t head) noexcept
+	: fundament_(fundament), depth_(depth), head_(head)
+{
+}
+
+void DecisionProblem::subproblems(const DepthSequence& input, std::vector<DecisionProblem>& result) const
+{
+	if (0 == depth_) { // special case
+		// arbitrarily choose dir to place the first disk at (0,0)
+		Fundament fundament = fundament_;
+		fundament.shift(Dir::RIGHT);
+		fundament.block({ 0, 0 });
+		result.push_back({ fundament, 1, CENTER });
+		return;
+	}
+
+	int diskDepth = input.depth(depth_);
+
+	// place disk next to the appropriate head
+	Coord head = 2 == diskDepth ? branchHead() : Coord{ 0, 0 };
+
+	// same choices and order as DynamicProblem::subproblems
+	Dir dirs[6] = { Dir::LEFT, Dir::LEFT_UP, Dir::LEFT_DOWN, Dir::RIGHT, Dir::RIGHT_UP, Dir::RIGHT_DOWN };
+	Dir* begin = 0 == diskDepth ? dirs + 3 : dirs; // spine is x-monotone
+
+	for (Dir* it = begin; it != dirs + 6; ++it) {
+		Coord c = head + *it;
+		if (fundament_.blocked(c))
+			continue;
+
+		Fundament fundament = fundament_;
+
+		switch (diskDepth) {
+		case 0: // spine
+			fundament.shift(*it);
+			fundament.block({ 0, 0 });
+			result.push_back({ fundament, depth_ + 1, CENTER });
+			break;
+
+		case 1: // branch
+			fundament.block(c);
+			result.push_back({ fundament, depth_ + 1, static_cast<std::int8_t>(Fundament::index(c)) });
+			break;
+
+		case 2: // leaf
+			fundament.block(c);
+			result.push_back({ fundament, depth_ + 1, head_ });
+			break;
+
+		}
+	}
+}
+
+const Fundament& DecisionProblem::fundament() const noexcept
+{
+	return fundament_;
+}
+
+Coord DecisionProblem::branchHead() const noexcept
+{
+	return Fundament::at(head_);
+}
+
+int DecisionProblem::depth() const noexcept
+{
+	return depth_;
+}
+
+Signature DecisionProblem::signature(const DepthSequence& input) const noexcept
+{
+	const ReachSchedule& schedule = input.schedule(depth_);
+
+	// consider branch head only if it is relevant at this point (upcoming leaf)
+	Coord head = schedule.leaf ? branchHead() : Coord{ 0, 0 };
+
+	// disregard unreachable spaces
+	Fundament fundament = reachableEventually(fundament_, head, schedule);
+
+	return normalSignature(depth_, fundament.mask, fundament.mirrored().mask, head);
+}
+
+void DecisionProblem::signatures(const std::vector<DecisionProblem>& problems, const DepthSequence& input, std::vector<Signature>& result)
+{
+	if (problems.empty())
+		return;
+
+	// siblings share the upcoming input
+	int depth = problems[0].depth_;
+	const ReachSchedule& schedule = input.schedule(depth);
+
+	for (std::size_t begin = 0; begin < problems.size(); begin += BATCH) {
+		std::size_t count = std::min(BATCH, problems.size() - begin);
+		std::array<std::uint32_t, BATCH> masks;
+		std::array<Coord, BATCH> heads;
+
+		for (std::size_t i = 0; i < count; i++) {
+			const DecisionProblem& problem = problems[begin + i];
+			assert(problem.depth_ == depth);
+
+			masks[i] = problem.fundament_.mask;
+			heads[i] = schedule.leaf ? problem.branchHead() : Coord{ 0, 0 };
+		}
+
+		batchSignatures(masks.data(), heads.data(), count, depth, schedule, result);
+	}
+}
+
+ClosedSet::ClosedSet(std::size_t n)
+	: sizes_(n + 1, 0)
+{
+}
+
+bool ClosedSet::dominated(const Signature& signature) const noexcept
+{
+	auto it = groups_.find(key(signature));
+	if (groups_.end() == it)
+		return false;
+
+	const Buckets& buckets = it->second;
+	std::uint32_t mask = signature.fundament.mask;
+	int count = std::popcount(mask);
+
+	// a known mask dominates if none of its blocked spaces are free in the new mask
+	for (int c = 0; c <= count; c++) {
+		for (std::uint32_t known : buckets[c]) {
+			if (0 == (known & ~mask))
+				return true;
+		}
+	}
+
+	return false;
+}
+
+void ClosedSet::insert(const Signature& signature)
+{
+	std::uint32_t mask = signature.fundament.mask;
+	int count = std::popcount(mask);
+	groups_[key(signature)][count].push_back(mask);
+	sizes_[signature.depth]++;
+}
+
+std::size_t ClosedSet::size(int depth) const noexcept
+{
+	return sizes_[depth];
+}
+
+int ClosedSet::key(const Signature& signature) noexcept
+{
+	int head = Fundament::index(signature.head);
+	assert(head >= 0);
+	return signature.depth * 25 + head;
+}
+
 namespace
 {
 	/**
 	 * Return @c true if problem @c rhs should be expanded before problem @c lhs.
 	 */
-	bool priority(const DynamicProblem& lhs, const DynamicProblem& rhs)
+	template<class Problem>
+	bool priority(const Problem& lhs, const Problem& rhs)
 	{
 		return lhs.depth() < rhs.depth(); // TODO: BFS vs DFS, consider fundament popcnt
 	}
 }
 
-ProblemQueue::ProblemQueue(std::size_t n)
-	: open_(&priority), closed_(n+1, SigSet(&less))
+template<class Problem>
+BasicProblemQueue<Problem>::BasicProblemQueue(std::size_t n)
+	: open_(&priority<Problem>), closed_(n)
 {
 }
 
-const DynamicProblem& ProblemQueue::top() const noexcept
+template<class Problem>
+const Problem& BasicProblemQueue<Problem>::top() const noexcept
 {
 	return open_.top();
 }
 
-void ProblemQueue::push(const DynamicProblem& problem)
+template<class Problem>
+void BasicProblemQueue<Problem>::push(const Problem& problem, const Signature& signature)
 {
-	auto signature = problem.signature();
-	SigSet& closed = closed_[problem.depth()];
-
-	// We want to compare the new signature to the known ones.
-	// Since both open_ and closed_ are locally ordered by fundament bit count,
-	// we can quickly query the few comparable entries.
-	auto lowerSig = signature;
-	lowerSig.fundament.mask = 0; // all unblocked
-	auto upperSig = signature;
-	upperSig.fundament.mask.set(); // all blocked
-
 	// If we previously encountered a dominating signature, we have no need for the new one.
-	for (auto it = closed.lower_bound(lowerSig),
-	         end = closed.upper_bound(upperSig); it != end; ++it) {
-		if (it->dominates(signature))
-			return;
-	}
+	if (closed_.dominated(signature))
+		return;
 
 	open_.push(problem);
-	closed.insert(signature);
+	closed_.insert(signature);
 }
 
-void ProblemQueue::pop()
+template<class Problem>
+void BasicProblemQueue<Problem>::pop()
 {
 	open_.pop();
 }
 
-bool ProblemQueue::empty() const noexcept
+template<class Problem>
+bool BasicProblemQueue<Problem>::empty() const noexcept
 {
 	return open_.empty();
 }
 
-bool ProblemQueue::less(const Signature& lhs, const Signature& rhs) noexcept
+template<class Problem>
+const ClosedSet& BasicProblemQueue<Problem>::closed() const noexcept
 {
-	if (lhs.depth < rhs.depth) return true;
-	if (lhs.depth > rhs.depth) return false;
-
-	if (lhs.head.x < rhs.head.x) return true;
-	if (lhs.head.x > rhs.head.x) return false;
-
-	if (lhs.head.sly < rhs.head.sly) return true;
-	if (lhs.head.sly > rhs.head.sly) return false;
+	return closed_;
+}
 
-	if (lhs.fundament.mask.count() < rhs.fundament.mask.count()) return true;
-	if (lhs.fundament.mask.count() > rhs.fundament.mask.count()) return false;
+template class BasicProblemQueue<DynamicProblem>;
+template class BasicProblemQueue<DecisionProblem>;
 
-	return lhs.fundament.mask.to_ulong() < rhs.fundament.mask.to_ulong();
+void ProblemQueue::push(const DynamicProblem& problem)
+{
+	push(problem, problem.signature());
 }
 
 bool ProblemQueue::equivalent(const DynamicProblem& lhs, const DynamicProblem& rhs) noexcept
@@ -522,44 +899,67 @@ bool ProblemQueue::equivalent(const DynamicProblem& lhs, const DynamicProblem& r
 	return lhs.signature() == rhs.signature();
 }
 
-DynamicProblemEmbedder::DynamicProblemEmbedder(bool constructive) noexcept
-	: WholesaleEmbedder(), constructive_(constructive)
+namespace
 {
-}
+	/**
+	 * Expand the problems in the queue until a problem of full @c size is at the top.
+	 *
+	 * The @c expand function appends the subproblems of a given problem and
+	 * their signatures to the given vectors.
+	 *
+	 * @return @c true if a complete problem was found, @c false if the queue ran empty
+	 */
+	template<class Problem, class Expand>
+	bool search(BasicProblemQueue<Problem>& queue, int size, Expand expand)
+	{
+		// performance counters
+		int pushCounter = 1; // root problem
+		int popCounter = 0;
 
-bool DynamicProblemEmbedder::embed(DiskGraph& graph)
-{
-	// performance counters
-	int pushCounter = 0;
-	int popCounter = 0;
+		std::vector<Problem> subproblems;
+		std::vector<Signature> signatures;
 
-	ProblemQueue queue(graph.size());
-	queue.push(DynamicProblem(graph, constructive_));
-	pushCounter++;
+		while (!queue.empty()) {
+			const Problem& next = queue.top();
 
-	while (!queue.empty()) {
-		const DynamicProblem& next = queue.top();
+			if (next.depth() == size)
+				break; // accept solution - this solves all parent problems
 
-		if (next.depth() == graph.size()) {
-			// accept solution - this solves all parent problems
-			if (constructive_)
-				next.solution().apply();
-			break;
+			subproblems.clear();
+			signatures.clear();
+			expand(next, subproblems, signatures);
+			queue.pop();
+			popCounter++;
+
+			for (std::size_t i = 0; i < subproblems.size(); i++) {
+				queue.push(subproblems[i], signatures[i]);
+				pushCounter++;
+			}
 		}
 
-		auto subproblems = next.subproblems();
-		queue.pop();
-		popCounter++;
+		trace("Dynamic Problems: {} generated, {} expanded.", pushCounter, popCounter);
 
-		for (const DynamicProblem& problem : subproblems) {
-			queue.push(problem);
-			pushCounter++;
+		if (theLog->level() <= Configuration::LogLevel::TRACE) {
+			std::string sizes;
+			for (int depth = 0; depth <= size; depth++)
+				sizes += (depth ? ", " : "") + std::to_string(queue.closed().size(depth));
+			trace("Closed signatures by depth: {}.", sizes);
 		}
+
+		return !queue.empty();
 	}
+}
+
+DynamicProblemEmbedder::DynamicProblemEmbedder(bool constructive) noexcept
+	: WholesaleEmbedder(), constructive_(constructive)
+{
+}
 
-	trace("Dynamic Problems: {} generated, {} expanded.", pushCounter, popCounter);
+bool DynamicProblemEmbedder::embed(DiskGraph& graph)
+{
+	bool success = constructive_ ? construct(graph) : decide(graph);
 
-	if (queue.empty()) {
+	if (!success) {
 		// no embedding found - mark all disks failed
 		for (Disk& disk : graph.disks()) {
 			disk.failure = true;
@@ -567,5 +967,40 @@ bool DynamicProblemEmbedder::embed(DiskGraph& graph)
 		trace("No solution found.");
 	}
 
-	return !queue.empty();
+	return success;
+}
+
+bool DynamicProblemEmbedder::construct(DiskGraph& graph)
+{
+	// partial solutions of all problems, released in bulk at the end
+	SolutionTree tree(graph);
+
+	ProblemQueue queue(graph.size());
+	queue.push(DynamicProblem(graph, &tree));
+
+	bool success = search(queue, static_cast<int>(graph.size()),
+		[](const DynamicProblem& problem, std::vector<DynamicProblem>& subproblems, std::vector<Signature>& signatures) {
+			subproblems = problem.subproblems();
+			signatures = DynamicProblem::signatures(subproblems);
+		});
+
+	if (success)
+		queue.top().solution().apply();
+
+	return success;
+}
+
+bool DynamicProblemEmbedder::decide(DiskGraph& graph)
+{
+	DepthSequence input(graph);
+
+	BasicProblemQueue<DecisionProblem> queue(graph.size());
+	DecisionProblem root;
+	queue.push(root, root.signature(input));
+
+	return search(queue, input.size(),
+		[&input](const DecisionProblem& problem, std::vector<DecisionProblem>& subproblems, std::vector<Signature>& signatures) {
+			problem.subproblems(input, subproblems);
+			DecisionProblem::signatures(subproblems, input, signatures);
+		});
 }
@@ -2,10 +2,10 @@
 
 #pragma once
 
-#include <bitset>
+#include <array>
 #include <queue>
-#include <set>
-#include <memory>
+#include <unordered_map>
+#include <cstdint>
 #include "utility/grid.h"
 #include "utility/geometry.h"
 #include "utility/graph.h"
@@ -20,12 +20,12 @@
  * location of the spine head.
  *
  * The representation uses a bitmask in which the bit number <tt>n = (sly+x+2)*5 + (x+2)</tt>
- * is set to @c true if the grid location <tt>(x,sly): (sly+x) &#8712; [-2,2], x &#8712; [-2,2]</tt>
- * relative to the spine head is blocked, @c false if it is free.
+ * is set to @c 1 if the grid location <tt>(x,sly): (sly+x) &#8712; [-2,2], x &#8712; [-2,2]</tt>
+ * relative to the spine head is blocked, @c 0 if it is free. Bits 25 through 31 are always 0.
  */
 struct Fundament
 {
-	std::bitset<25> mask;
+	std::uint32_t mask = 0;
 
 	Fundament() noexcept;
 	Fundament(const Fundament& rhs) noexcept;
@@ -77,12 +77,105 @@ struct Fundament
 	 */
 	Fundament reachableBySpine(Coord from) const noexcept;
 
+	/**
+	 * @brief Return the fundament mirrored along the x axis through the spine head.
+	 *
+	 * Local coordinate <tt>(x,sly)</tt> maps to <tt>(x+sly,-sly)</tt>.
+	 */
+	Fundament mirrored() const noexcept;
+
 	// print to stdout
 	[[maybe_unused]]
 	void print() const;
 
+	/**
+	 * @name Word-level cell sets
+	 *
+	 * These helpers operate on sets of cells in the same bit layout as the
+	 * mask, but as plain integers. Neighbors of bit @c n in the six grid
+	 * directions are at bit offsets -6, -1, +5, +6, +1 and -5, provided that
+	 * the x coordinate does not leave the range [-2,2].
+	 */
+	///@{
+
+	static const std::uint32_t ALL; //!< all cells
+	static const std::uint32_t LEFTMOST; //!< cells at local x = -2
+	static const std::uint32_t RIGHTMOST; //!< cells at local x = 2
+
+	/**
+	 * @brief Return the given cells together with all their neighbors.
+	 */
+	static constexpr std::uint32_t grow(std::uint32_t cells) noexcept;
+
+	/**
+	 * @brief Return the cells which follow the given cells in one spine step.
+	 *
+	 * These are the neighbors in x-monotone directions (up, right, right-down).
+	 */
+	static constexpr std::uint32_t spineStep(std::uint32_t cells) noexcept;
+
+	/**
+	 * @brief Return the given cells mirrored along the x axis through the center.
+	 *
+	 * In the bit layout, this is the transposition of a 5x5 bit matrix, which
+	 * we perform with one delta swap for each of the four diagonals.
+	 */
+	static constexpr std::uint32_t transpose(std::uint32_t cells) noexcept;
+
+	static const std::array<std::uint32_t, 25> NEIGHBORS; //!< neighbor cells by bit
+	static const std::array<std::uint32_t, 25> SPINE_NEIGHBORS; //!< spine step cells by bit
+
+	///@}
+
 };
 
+inline constexpr std::uint32_t Fundament::ALL = 0x1ffffff;
+inline constexpr std::uint32_t Fundament::LEFTMOST = 0x0108421;
+inline constexpr std::uint32_t Fundament::RIGHTMOST = 0x1084210;
+
+constexpr std::uint32_t Fundament::grow(std::uint32_t cells) noexcept
+{
+	std::uint32_t left = cells & ~LEFTMOST;
+	std::uint32_t right = cells & ~RIGHTMOST;
+	return (cells | cells << 5 | cells >> 5 |
+		right << 1 | right << 6 | left >> 1 | left >> 6) & ALL;
+}
+
+constexpr std::uint32_t Fundament::spineStep(std::uint32_t cells) noexcept
+{
+	std::uint32_t right = cells & ~RIGHTMOST;
+	return (cells << 5 | right << 6 | right << 1) & ALL;
+}
+
+constexpr std::uint32_t Fundament::transpose(std::uint32_t cells) noexcept
+{
+	// swap bit 5*v+u (u > v) with bit 5*u+v, which lies 4*(u-v) positions higher
+	std::uint32_t t;
+	t = (cells ^ cells >> 4) & 0x0082082; // u - v = 1
+	cells ^= t | t << 4;
+	t = (cells ^ cells >> 8) & 0x0004104; // u - v = 2
+	cells ^= t | t << 8;
+	t = (cells ^ cells >> 12) & 0x0000208; // u - v = 3
+	cells ^= t | t << 12;
+	t = (cells ^ cells >> 16) & 0x0000010; // u - v = 4
+	cells ^= t | t << 16;
+	return cells;
+}
+
+inline constexpr std::array<std::uint32_t, 25> Fundament::NEIGHBORS = [] {
+	std::array<std::uint32_t, 25> table{};
+	for (int bit = 0; bit < 25; bit++)
+		table[bit] = grow(1u << bit) & ~(1u << bit);
+	return table;
+}();
+
+inline constexpr std::array<std::uint32_t, 25> Fundament::SPINE_NEIGHBORS = [] {
+	std::array<std::uint32_t, 25> table{};
+	for (int bit = 0; bit < 25; bit++)
+		table[bit] = spineStep(1u << bit);
+	return table;
+}();
+
 /**
  * @brief The identifying components of a partial dynamic programming problem in
  * the context of solving a particular lobster.
@@ -111,6 +204,59 @@ struct Signature
 
 using InputDisks = std::vector<Disk>; // complete input
 
+/**
+ * @brief Arena for the partial embeddings of constructive dynamic problems.
+ *
+ * Every node records the placement of one disk and refers to the node of the
+ * partial embedding that it extends by index. The nodes of all problems of one
+ * embedding run are stored contiguously and freed together with the tree.
+ */
+class SolutionTree
+{
+
+public:
+
+	/**
+	 * @brief Parent index of nodes which extend the empty embedding.
+	 */
+	static constexpr int ROOT = -1;
+
+	/**
+	 * Construct an empty tree over the disks of the given graph.
+	 */
+	explicit SolutionTree(DiskGraph& graph);
+
+	/**
+	 * @brief Record the placement of the given disk on top of the @c parent node.
+	 *
+	 * @return the index of the new node
+	 */
+	int add(int parent, Coord placement, const Disk& disk);
+
+	/**
+	 * @brief Construct the partial embedding which ends in the given @c node.
+	 */
+	Grid solution(int node) const;
+
+	/**
+	 * @brief Return the number of nodes in the tree.
+	 */
+	std::size_t size() const noexcept;
+
+private:
+
+	struct Node
+	{
+		Coord placement; //!< coord of the disk placed in this step
+		int parent; //!< index of the previous node or @c ROOT
+		int disk; //!< index of the placed disk in the graph
+	};
+
+	DiskGraph* graph_;
+	std::vector<Node> nodes_;
+
+};
+
 /**
  * An instance of the dynamic programming problem.
  *
@@ -125,37 +271,30 @@ public:
 	/**
 	 * @brief Create the root problem of the graph instance.
 	 *
-	 * If the @c constructive flag is set to @c true, the embedding solution
-	 * will be available from the final subproblem. Otherwise, the problem
-	 * can only be used to decide whether an embedding is possible or not.
+	 * If a solution @c tree is given, the embedding solution will be
+	 * available from the final subproblem. Otherwise, the problem can only
+	 * be used to decide whether an embedding is possible or not.
+	 * The tree must outlive all problems derived from this one.
 	 */
-	explicit DynamicProblem(DiskGraph& graph, bool constructive = true);
+	explicit DynamicProblem(DiskGraph& graph, SolutionTree* tree = nullptr);
 
 private:
 
 	/**
-	 * @brief Create the child problem of the given constructive problem.
+	 * @brief Create the child problem of the given problem.
 	 *
 	 * The next disk is to be placed in the given direction from the
 	 * appropriate head (spine head or branch head).
 	 *
-	 * All children of the parent share the parent pointer because the
-	 * original parent usually does not outlive the children.
+	 * If the parent is constructive, the placement is recorded in its tree.
 	 */
-	DynamicProblem(std::shared_ptr<const DynamicProblem> parent, Dir dir);
+	DynamicProblem(const DynamicProblem& parent, Dir dir);
 
 	/**
-	 * @brief Create the child problem of the given decision problem.
-	 *
-	 * The next disk is to be placed in the given direction from the
-	 * appropriate head (spine head or branch head).
-	 */
-	DynamicProblem(const DynamicProblem* parent, Dir dir);
-
-	/**
-	 * Shared helper to complete construction of this problem regarding placement.
+	 * Complete construction of this problem regarding placement.
+	 * Return the coordinate of the placed disk.
 	 */
-	void initPlacement(Dir dir);
+	Coord initPlacement(Dir dir);
 
 public:
 
@@ -201,6 +340,11 @@ public:
 	 */
 	int depth() const noexcept;
 
+	/**
+	 * @brief Return the position of the next disk to place in the input.
+	 */
+	GraphTraversal position() const noexcept;
+
 	/**
 	 * @brief Calculate the signaturue of the problem.
 	 *
@@ -210,6 +354,16 @@ public:
 	 */
 	Signature signature() const noexcept;
 
+	/**
+	 * @brief Calculate the signatures of sibling problems in one batch.
+	 *
+	 * All @c problems must have been derived from the same parent, such that
+	 * they share the same input position. The result is the same as calling
+	 * @c signature on every problem, but the fundaments of all problems are
+	 * processed together in vector registers where available.
+	 */
+	static std::vector<Signature> signatures(const std::vector<DynamicProblem>& problems);
+
 private:
 
 	Fundament fundament_; // spaces blocked by disks embedded so far
@@ -218,9 +372,8 @@ private:
 	GraphTraversal position_;
 	GraphTraversal end_; // TODO: eliminate
 	int depth_;
-	bool constructive_; // true if solution should be constructed, false to decide only
-	std::shared_ptr<const DynamicProblem> parent_; // problem that this problem was derived from (by placing another disk). TODO: store only embedding info
-	Coord placement_; // coord of last disk placed
+	SolutionTree* tree_; // partial solutions if constructive, nullptr to decide only
+	int node_; // node of the last disk placed in the tree
 
 };
 
@@ -242,40 +395,248 @@ private:
 Fundament reachableEventually(Fundament base, Coord head, GraphTraversal position, GraphTraversal end) noexcept;
 
 /**
- * @brief This queue supports the ordered expansion of DynamicProblems
- * from a set of open problems.
+ * @brief The properties of the remaining input which determine reachability.
+ *
+ * Problems at the same input position share the same schedule, even if their
+ * fundaments differ. The schedule ends where no spine placement is possible
+ * within the fundament any more.
+ */
+struct ReachSchedule
+{
+	static constexpr int MAX_SPINES = 5; //!< upcoming spines which can be placed in the fundament
+
+	bool leaf; //!< @c true if the upcoming disk is a leaf of the branch head
+	int spines; //!< number of upcoming spines which influence reachability
+	std::array<int, MAX_SPINES> reach; //!< max depth of disks on each upcoming spine
+
+	/**
+	 * @brief Extract the schedule of the input from @c position to @c end.
+	 */
+	static ReachSchedule of(GraphTraversal position, GraphTraversal end) noexcept;
+};
+
+/**
+ * @brief Determine the normalized base fundament with regards to reachability.
+ *
+ * Like the above function, but based on a precomputed schedule.
+ */
+Fundament reachableEventually(Fundament base, Coord head, const ReachSchedule& schedule) noexcept;
+
+/**
+ * @brief Flat description of the input disks for the decision procedure.
+ *
+ * It holds the depth of every disk in depth-first embedding order and the
+ * reach schedule of the remaining input at every position, such that
+ * decision problems need not refer to the graph.
+ */
+class DepthSequence
+{
+
+public:
+
+	/**
+	 * Extract the sequence from the given graph.
+	 *
+	 * @throw EmbedException if the graph is deeper than a lobster
+	 */
+	explicit DepthSequence(DiskGraph& graph);
+
+	/**
+	 * @brief Return the number of disks in the input.
+	 */
+	int size() const noexcept;
+
+	/**
+	 * @brief Return the depth of the disk at the given position (0 = spine, 1 = branch, 2 = leaf).
+	 */
+	int depth(int index) const noexcept;
+
+	/**
+	 * @brief Return the reach schedule of the input from the given position.
+	 */
+	const ReachSchedule& schedule(int index) const noexcept;
+
+private:
+
+	std::vector<std::int8_t> depths_;
+	std::vector<ReachSchedule> schedules_; // one more than disks for the end position
+
+};
+
+/**
+ * @brief Compact instance of the dynamic programming problem for deciding
+ * whether an embedding exists.
+ *
+ * Unlike DynamicProblem, it does not track absolute coordinates and only
+ * refers to the input by its position in the DepthSequence. The state fits
+ * in 12 bytes, so that the queue can hold many of them by value.
+ */
+class DecisionProblem
+{
+
+public:
+
+	/**
+	 * @brief Create the root problem, in which no disk is placed yet.
+	 */
+	DecisionProblem() noexcept;
+
+	/**
+	 * @brief Append the possible successor problems to the given vector.
+	 *
+	 * Construct the successors by placing the next disk in order at one of
+	 * the applicable free spaces, in the same order as DynamicProblem.
+	 */
+	void subproblems(const DepthSequence& input, std::vector<DecisionProblem>& result) const;
+
+	/**
+	 * @brief Return the current surroundings relevant to placement options.
+	 */
+	const Fundament& fundament() const noexcept;
+
+	/**
+	 * @brief Return the local coordinate of the last placed branch.
+	 */
+	Coord branchHead() const noexcept;
+
+	/**
+	 * @brief Return the number of disks placed so far (0 at the root problem).
+	 */
+	int depth() const noexcept;
+
+	/**
+	 * @brief Calculate the signature of the problem.
+	 *
+	 * The result is the same as for the equivalent DynamicProblem.
+	 */
+	Signature signature(const DepthSequence& input) const noexcept;
+
+	/**
+	 * @brief Calculate the signatures of sibling problems in one batch
+	 * and append them to the given vector.
+	 */
+	static void signatures(const std::vector<DecisionProblem>& problems, const DepthSequence& input, std::vector<Signature>& result);
+
+private:
+
+	Fundament fundament_; // spaces blocked by disks embedded so far, relative to the spine head
+	int depth_; // number of disks placed = position of the next disk in the input
+	std::int8_t head_; // fundament index of the branch head
+
+	DecisionProblem(Fundament fundament, int depth, std::int8_t head) noexcept;
+
+};
+
+/**
+ * @brief Index of the Signatures of already seen problems.
+ *
+ * Signatures are grouped by depth and head. Within each group, the fundament
+ * masks are bucketed by their number of blocked spaces. A known mask can only
+ * dominate a new mask if it has at most as many blocked spaces, so a dominance
+ * query only scans the lower buckets with one bitwise test per known mask.
+ */
+class ClosedSet
+{
+
+public:
+
+	/**
+	 * Construct a ClosedSet for problems of depth 0 through @c n.
+	 */
+	explicit ClosedSet(std::size_t n);
+
+	/**
+	 * @brief Determine whether any known Signature dominates the given one.
+	 */
+	bool dominated(const Signature& signature) const noexcept;
+
+	/**
+	 * @brief Add the given Signature to the set.
+	 */
+	void insert(const Signature& signature);
+
+	/**
+	 * @brief Return the number of Signatures known at the given depth.
+	 */
+	std::size_t size(int depth) const noexcept;
+
+private:
+
+	using Bucket = std::vector<std::uint32_t>; // fundament masks with the same count
+	using Buckets = std::array<Bucket, 26>; // indexed by number of blocked spaces
+
+	static int key(const Signature& signature) noexcept;
+
+	std::unordered_map<int, Buckets> groups_; // by depth and head
+	std::vector<std::size_t> sizes_; // number of signatures by depth
+
+};
+
+/**
+ * @brief This queue supports the ordered expansion of dynamic programming
+ * problems from a set of open problems.
  *
  * It identifies the next problem to expand based on a priority measure
  * (size of the problem).
  *
  * It eliminates redundancy by keeping at most one problem instance for
  * any problem equivalence class.
+ *
+ * The queue is instantiated for @c DynamicProblem and @c DecisionProblem.
  */
-class ProblemQueue
+template<class Problem>
+class BasicProblemQueue
 {
 
 public:
 
 	/**
-	 * Construct a ProblemQueue for solving a lobster with @c n vertices.
+	 * Construct a queue for solving a lobster with @c n vertices.
 	 */
-	explicit ProblemQueue(std::size_t n);
+	explicit BasicProblemQueue(std::size_t n);
 
-	const DynamicProblem& top() const noexcept;
-	void push(const DynamicProblem& problem);
+	const Problem& top() const noexcept;
+
+	/**
+	 * @brief Push the given problem with its precomputed signature.
+	 */
+	void push(const Problem& problem, const Signature& signature);
 	void pop();
 	bool empty() const noexcept;
 
 	/**
-	 * Define a weak ordering on Signatures such that Signatures of the same
-	 * size and same head are grouped next to each other, and Signatures
-	 * with smaller Fundaments (less blocked spaces) are less than Signatures
-	 * with larger Fundaments.
-	 *
-	 * This allows us to quickly find out if the "dominance" heuristic
-	 * applies to a problem to be pushed.
+	 * @brief Access the signatures of all problems pushed so far.
+	 */
+	const ClosedSet& closed() const noexcept;
+
+private:
+
+	// problems to be expanded
+	using OrderFunction = bool(*)(const Problem& lhs, const Problem& rhs);
+	std::priority_queue<Problem, std::vector<Problem>, OrderFunction> open_;
+
+	ClosedSet closed_; // signatures of already seen problems
+
+};
+
+extern template class BasicProblemQueue<DynamicProblem>;
+extern template class BasicProblemQueue<DecisionProblem>;
+
+/**
+ * @brief The queue for constructive problems.
+ */
+class ProblemQueue : public BasicProblemQueue<DynamicProblem>
+{
+
+public:
+
+	using BasicProblemQueue<DynamicProblem>::BasicProblemQueue;
+	using BasicProblemQueue<DynamicProblem>::push;
+
+	/**
+	 * @brief Push the given problem, computing its signature.
 	 */
-	static bool less(const Signature& lhs, const Signature& rhs) noexcept;
+	void push(const DynamicProblem& problem);
 
 	/**
 	 * @brief Determine whether two given problems are equivalently solvable.
@@ -288,16 +649,6 @@ public:
 	 */
 	static bool equivalent(const DynamicProblem& lhs, const DynamicProblem& rhs) noexcept;
 
-private:
-
-	// problems to be expanded
-	using OrderFunction = bool(*)(const DynamicProblem& lhs, const DynamicProblem& rhs);
-	std::priority_queue<DynamicProblem, std::deque<DynamicProblem>, OrderFunction> open_;
-
-	// set of hashes of already seen problems
-	using SigSet = std::set<Signature, decltype(&less)>;
-	std::vector<SigSet> closed_; // one sigset for each problem depth
-
 };
 
 /**
@@ -327,4 +678,7 @@ private:
 
 	bool constructive_;
 
+	bool construct(DiskGraph& graph); // search with DynamicProblem, apply solution
+	bool decide(DiskGraph& graph); // search with DecisionProblem
+
 };
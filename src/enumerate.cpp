@@ -19,14 +19,19 @@ Enumerate::Enumerate(Embedder& fast, WholesaleEmbedder& reference, int minSize,
 
 void Enumerate::next()
 {
-	auto& spine = current_.spine();
+	advance(current_, evaluation_.solved);
+}
+
+void Enumerate::advance(Lobster& lobster, bool solved)
+{
+	auto& spine = lobster.spine();
 	const auto NB = Lobster::NO_BRANCH;
 
 	int i = spine.size() - 1; // spine index
 	int j = 4; // branch index
 
 	// reference-based skip: we do not evaluate the bigger lobsters after a fail
-	if (!evaluation_.solved) {
+	if (!solved) {
 		// remove the last branch from the back
 		while (i >= 0) {
 			for (j = 4; j >= 0; j--) {
@@ -57,7 +62,7 @@ addleaf:
 		if (spine[i][j] < 5) { // we can increment here
 			spine[i][j]++;
 
-			if (isCanonicallyOriented(current_)) {
+			if (isCanonicallyOriented(lobster)) {
 				return; // success
 			}
 			else {
@@ -82,7 +87,7 @@ addleaf:
 
 	// all possibilities iterated - enlarge spine
 	Lobster::Spine empty = { NB, NB, NB, NB, NB };
-	current_ = Lobster(std::vector<Lobster::Spine>(spine.size() + 1, empty));
+	lobster = Lobster(std::vector<Lobster::Spine>(spine.size() + 1, empty));
 }
 
 const Evaluation& Enumerate::test()
@@ -194,6 +199,15 @@ void Enumerate::setCurrent(Lobster lobster) noexcept
 	evaluation_.refStat.success = true;
 }
 
+void Enumerate::setCurrent(Lobster lobster, bool solved) noexcept
+{
+	current_ = std::move(lobster);
+	evaluation_.solved = solved;
+	evaluation_.bfsStat.success = solved;
+	evaluation_.dfsStat.success = solved;
+	evaluation_.refStat.success = solved;
+}
+
 void Enumerate::setHeuristicBfsEnabled(bool enabled) noexcept
 {
 	heuristicBfsEnabled_ = enabled;
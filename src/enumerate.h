@@ -25,6 +25,20 @@ struct Evaluation
 	DiskGraph refResult; // embedding from reference algorithm
 };
 
+/**
+ * A partition of the enumeration consists of all the lobsters of one spine
+ * length which share the same configuration of the first spine vertex.
+ *
+ * The enumeration changes the first spine only when all following spines are
+ * empty, so every partition begins with the lobster that has only empty spines
+ * after the first.
+ */
+struct Partition
+{
+	int spines; //!< number of spine vertices in all lobsters of the partition
+	Lobster::Spine head; //!< branch configuration of the first spine vertex
+};
+
 /**
  * This enumerator implements an iterator pattern to generate a specified
  * range of Lobster instances.
@@ -65,6 +79,14 @@ public:
 	 */
 	void next();
 
+	/**
+	 * @brief Advance the given lobster to its successor in the enumeration.
+	 *
+	 * This implements @c next for any lobster, where @c solved is the evaluation
+	 * result of the given lobster.
+	 */
+	static void advance(Lobster& lobster, bool solved);
+
 	/**
 	 * Run the embedding algorithms on the current lobster and record the results
 	 * in the statistics. The success or failure determines the behavior of the @c next
@@ -92,6 +114,12 @@ public:
 	 */
 	void setCurrent(Lobster lobster) noexcept;
 
+	/**
+	 * Set the current Lobster instance together with the result of its evaluation,
+	 * which determines how @c next advances from it.
+	 */
+	void setCurrent(Lobster lobster, bool solved) noexcept;
+
 	/**
 	 * Set whether the heuristic with @c BREADTH_FIRST @c EmbedOrder is included in the benchmark.
 	 */
@@ -5,6 +5,25 @@
 
 const int MAX_PROBLEM_SIZE = 100; //!< size of instances to generate
 
+bool binary = false; //!< write edge lists in binary instead of text format
+
+/**
+ * Write the edges to a file whose name consists of the category and size.
+ */
+void write_edges(const std::string& category, int size, const EdgeList& edges)
+{
+	std::string file = category + std::to_string(size) + (binary ? ".bin" : ".txt");
+
+	if (binary) {
+		std::ofstream stream{ file, std::ios::binary };
+		edges_to_binary(stream, edges);
+	}
+	else {
+		std::ofstream stream{ file };
+		edges_to_text(stream, edges);
+	}
+}
+
 /**
  * Generate lobsters with a lot of branches.
  *
@@ -57,10 +76,7 @@ void max_branches(int size)
 	edges.push_back({ extras + 12, 2 * size }); // extra leaf on start branch
 	edges.push_back({ extras + 13, 3 * size - 1 }); // extra leaf on end branch
 
-	std::string file = "maxbranches" + std::to_string(size) + ".txt";
-	std::ofstream stream{ file };
-	edges_to_text(stream, edges);
-	stream.close();
+	write_edges("maxbranches", size, edges);
 }
 
 /**
@@ -141,10 +157,7 @@ void max_leaves(int size)
 			edges.push_back({ branch, ++n });
 	}
 
-	std::string file = "maxleaves" + std::to_string(size) + ".txt";
-	std::ofstream stream{ file };
-	edges_to_text(stream, edges);
-	stream.close();
+	write_edges("maxleaves", size, edges);
 }
 
 /**
@@ -229,10 +242,7 @@ void onesided_bent(int size)
 			edges.push_back({ branch, ++n });
 	}
 
-	std::string file = "onesided_bent" + std::to_string(size) + ".txt";
-	std::ofstream stream{ file };
-	edges_to_text(stream, edges);
-	stream.close();
+	write_edges("onesided_bent", size, edges);
 }
 
 /**
@@ -309,14 +319,13 @@ void onesided_straight(int size)
 			edges.push_back({ branch, ++n });
 	}
 
-	std::string file = "onesided_straight" + std::to_string(size) + ".txt";
-	std::ofstream stream{ file };
-	edges_to_text(stream, edges);
-	stream.close();
+	write_edges("onesided_straight", size, edges);
 }
 
 int main(int argc, const char* argv[])
 {
+	binary = argc > 1 && "--binary" == std::string(argv[1]);
+
 	std::cout << "Generate input graphs up to size " << MAX_PROBLEM_SIZE << ".\n";
 
 	std::cout << "Run generators...\n";
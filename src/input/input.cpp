@@ -1,6 +1,8 @@
 #include "input.h"
 #include "utility/exception.h"
 #include <string>
+#include <charconv>
+#include <cctype>
 #include <cstring>
 #include <cassert>
 
@@ -59,3 +61,79 @@ std::istream& ignoreline(std::istream& stream)
 
     return stream;
 }
+
+namespace
+{
+
+bool isSpace(char c) noexcept
+{
+    return std::isspace(static_cast<unsigned char>(c));
+}
+
+// the next whitespace-delimited token, for error messages
+std::string token(std::string_view text)
+{
+    std::size_t end = 0;
+    while (end < text.size() && !isSpace(text[end]))
+        end++;
+    return std::string(text.substr(0, end));
+}
+
+}
+
+bool readint(std::string_view& text, int& output, int minValue, int maxValue)
+{
+    assert(minValue <= maxValue);
+
+    std::size_t start = 0;
+    while (start < text.size() && isSpace(text[start]))
+        start++;
+
+    if (start == text.size()) {
+        text.remove_prefix(start);
+        return false;
+    }
+
+    const char* first = text.data() + start;
+    const char* last = text.data() + text.size();
+    if ('+' == *first && last - first > 1 && '-' != first[1]) // accepted by streams, but not by from_chars
+        first++;
+
+    int o = minValue;
+    const auto [ptr, ec] = std::from_chars(first, last, o);
+
+    if (ec != std::errc{}) {
+        throw InputException("Failed to read degree number.", "", token(text.substr(start)));
+    }
+
+    if (o < minValue) {
+        throw InputException("Read value {} is less than min value {}.", o, minValue);
+    }
+    if (o > maxValue) {
+        throw InputException("Read value {} is greater than max value {}.", o, maxValue);
+    }
+
+    output = o;
+    text.remove_prefix(ptr - text.data());
+    return true;
+}
+
+void ignoreline(std::string_view& text)
+{
+    std::size_t i = 0;
+
+    for (; i < text.size(); i++) {
+        const char sp = text[i];
+        if (isSpace(sp)) { // swallow spaces
+            if ('\n' == sp) {
+                i++;
+                break;
+            }
+        }
+        else {
+            throw InputException("Expected new line.", "", token(text.substr(i)));
+        }
+    }
+
+    text.remove_prefix(i);
+}
@@ -6,6 +6,7 @@
 #pragma once
 
 #include <istream>
+#include <string_view>
 #include <limits>
 
 /**
@@ -33,3 +34,29 @@ std::istream& readint(std::istream& stream, int& output, int minValue = 0, int m
  * @throw InputException if any unexpected non-spaces occur
  */
 std::istream& ignoreline(std::istream& stream);
+
+/**
+ * @brief Read an integer from the front of the given text.
+ *
+ * This is the in-memory counterpart to reading from a stream.
+ * Leading spaces, including newlines, are skipped. On success, the text is
+ * advanced past the integer.
+ *
+ * @param text[in,out] remaining source text
+ * @param output[out] integer to write the result to
+ * @param minValue ensure that output is greater or equal
+ * @param maxValue ensure that output is less or equal
+ * @return true if an integer was read, false if the text holds no more tokens
+ * @throw InputException if the next token is not an integer in range
+ */
+bool readint(std::string_view& text, int& output, int minValue = 0, int maxValue = std::numeric_limits<int>::max());
+
+/**
+ * @brief Ignore space characters, including the first newline, from the front of the given text.
+ *
+ * This is the in-memory counterpart to reading from a stream.
+ *
+ * @param text[in,out] remaining source text
+ * @throw InputException if any unexpected non-spaces occur
+ */
+void ignoreline(std::string_view& text);
@@ -0,0 +1,83 @@
+#include "mapped.h"
+#include "utility/exception.h"
+#include <cstring>
+#include <cerrno>
+#if defined(_WIN32)
+#include <fstream>
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(_WIN32)
+
+MappedFile::MappedFile(const std::filesystem::path& path)
+	: data_(nullptr), size_(0), buffer_()
+{
+	std::ifstream stream{ path, std::ios::binary };
+	if (!stream.is_open())
+		throw InputException(std::strerror(errno), path.string());
+
+	buffer_.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+	if (stream.bad())
+		throw InputException(std::strerror(errno), path.string());
+
+	data_ = buffer_.data();
+	size_ = buffer_.size();
+}
+
+MappedFile::~MappedFile() noexcept = default;
+
+#else
+
+MappedFile::MappedFile(const std::filesystem::path& path)
+	: data_(nullptr), size_(0)
+{
+	const int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+		throw InputException(std::strerror(errno), path.string());
+
+	struct stat info;
+	if (::fstat(fd, &info) < 0) {
+		const int error = errno;
+		::close(fd);
+		throw InputException(std::strerror(error), path.string());
+	}
+
+	size_ = static_cast<std::size_t>(info.st_size);
+
+	if (size_ > 0) { // mmap rejects empty mappings
+		void* data = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (MAP_FAILED == data) {
+			const int error = errno;
+			::close(fd);
+			throw InputException(std::strerror(error), path.string());
+		}
+
+		::madvise(data, size_, MADV_SEQUENTIAL);
+		data_ = static_cast<const char*>(data);
+	}
+
+	::close(fd); // the mapping stays valid
+}
+
+MappedFile::~MappedFile() noexcept
+{
+	if (data_)
+		::munmap(const_cast<char*>(data_), size_);
+}
+
+#endif
+
+std::string_view MappedFile::view() const noexcept
+{
+	return { data_, size_ };
+}
+
+std::size_t MappedFile::size() const noexcept
+{
+	return size_;
+}
@@ -0,0 +1,55 @@
+/**
+ * Read-only access to whole input files.
+ */
+#pragma once
+
+#include <filesystem>
+#include <string_view>
+#include <cstddef>
+#if defined(_WIN32)
+#include <vector>
+#endif
+
+/**
+ * @brief The complete contents of a file, mapped into memory for reading.
+ *
+ * On POSIX systems, the file is mapped with @c mmap, such that the parser can
+ * scan it in place without copying through a stream buffer.
+ * Elsewhere, the contents are read into memory in one piece.
+ */
+class MappedFile
+{
+
+public:
+
+	/**
+	 * @brief Map the given file.
+	 *
+	 * @throw InputException if the file cannot be opened or mapped
+	 */
+	explicit MappedFile(const std::filesystem::path& path);
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	~MappedFile() noexcept;
+
+	/**
+	 * @brief Return the file contents.
+	 */
+	std::string_view view() const noexcept;
+
+	/**
+	 * @brief Return the size of the file in bytes.
+	 */
+	std::size_t size() const noexcept;
+
+private:
+
+	const char* data_;
+	std::size_t size_;
+#if defined(_WIN32)
+	std::vector<char> buffer_;
+#endif
+
+};
@@ -3,6 +3,8 @@
 #include "heuristic.h"
 #include "dynamic.h"
 #include "enumerate.h"
+#include "parallel.h"
+#include "input/mapped.h"
 #include "utility/graph.h"
 #include "utility/exception.h"
 #include "utility/log.h"
@@ -120,22 +122,39 @@ DiskGraph read_input_graph()
 	DiskGraph graph;
 
 	info("Process input file {}...", configuration.inputFile);
-	std::ifstream stream{ configuration.inputFile };
-	if (!stream.is_open())
-		throw InputException(std::strerror(errno), configuration.inputFile.string());
 
 	switch (configuration.inputFormat) {
 
 	case Configuration::InputFormat::DEGREES:
 	{
+		std::ifstream stream{ configuration.inputFile };
+		if (!stream.is_open())
+			throw InputException(std::strerror(errno), configuration.inputFile.string());
+
 		graph = DiskGraph::fromCaterpillar(Caterpillar::fromText(stream));
+
+		stream.clear();
+		stream.close();
+
+		if (stream.fail())
+			throw InputException(std::strerror(errno), configuration.inputFile.string());
 	}
 	break;
 
 	default:
 	case Configuration::InputFormat::EDGELIST:
+	case Configuration::InputFormat::BINARY:
 	{
-		EdgeList edges = edges_from_text(stream);
+		EdgeList edges;
+
+		{
+			MappedFile file{ configuration.inputFile };
+
+			if (Configuration::InputFormat::BINARY == configuration.inputFormat)
+				edges = edges_from_binary(file.view());
+			else
+				edges = edges_from_text(file.view());
+		}
 
 		if (edges.empty())
 			throw InputException("Graph is empty.", configuration.inputFile.string());
@@ -147,12 +166,6 @@ DiskGraph read_input_graph()
 
 	}
 
-	stream.clear();
-	stream.close();
-
-	if (stream.fail())
-		throw InputException(std::strerror(errno), configuration.inputFile.string());
-
 	return graph;
 }
 
@@ -206,6 +219,31 @@ void run_benchmark()
 	bool doStats = !configuration.statsFile.empty();
 	bool doArchive = !configuration.archiveYes.empty() || !configuration.archiveNo.empty();
 
+	if (configuration.threads > 1) {
+		ParallelEnumerate enumerate(configuration.spineMin, configuration.spineMax, configuration.threads);
+		enumerate.setHeuristicBfsEnabled(configuration.benchmarkBfs);
+		enumerate.setHeuristicDfsEnabled(configuration.benchmarkDfs);
+		enumerate.setDynamicProgramEnabled(configuration.benchmarkDynamic);
+
+		if (doStats) {
+			csv.open(configuration.statsFile, std::ios::out | std::ios::trunc);
+			enumerate.setCsv(&csv);
+		}
+
+		if (doArchive) {
+			archive.setPaths(configuration.archiveYes, configuration.archiveNo);
+			enumerate.setArchive(&archive);
+		}
+
+		enumerate.run();
+
+		if (doStats) {
+			csv.close();
+		}
+
+		return;
+	}
+
 	WeakEmbedder fastEmbedder;
 	DynamicProblemEmbedder referenceEmbedder(doInstances);
 	Enumerate enumerate(fastEmbedder, referenceEmbedder, configuration.spineMin, configuration.spineMax);
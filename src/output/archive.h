@@ -1,5 +1,7 @@
 // Output routine for degree files
 
+#pragma once
+
 #include "utility/graph.h"
 #include <filesystem>
 
@@ -0,0 +1,231 @@
+#include "parallel.h"
+#include "heuristic.h"
+#include "dynamic.h"
+#include "utility/log.h"
+#include <thread>
+#include <algorithm>
+#include <cassert>
+
+ParallelEnumerate::ParallelEnumerate(int minSize, int maxSize, int threads) noexcept
+	: minSize_(minSize), maxSize_(maxSize), threads_(threads),
+	heuristicBfsEnabled_(true), heuristicDfsEnabled_(true), dynamicProgramEnabled_(true),
+	csv_(nullptr), archive_(nullptr), stats_(),
+	mutex_(), changed_(), slots_(), taken_(0), chainDone_(false), error_()
+{
+	assert(minSize >= 0);
+	assert(minSize < maxSize);
+	assert(threads >= 1);
+}
+
+void ParallelEnumerate::setHeuristicBfsEnabled(bool enabled) noexcept
+{
+	heuristicBfsEnabled_ = enabled;
+}
+
+void ParallelEnumerate::setHeuristicDfsEnabled(bool enabled) noexcept
+{
+	heuristicDfsEnabled_ = enabled;
+}
+
+void ParallelEnumerate::setDynamicProgramEnabled(bool enabled) noexcept
+{
+	dynamicProgramEnabled_ = enabled;
+}
+
+void ParallelEnumerate::setCsv(Csv* csv) noexcept
+{
+	csv_ = csv;
+}
+
+void ParallelEnumerate::setArchive(Archive* archive) noexcept
+{
+	archive_ = archive;
+}
+
+const std::vector<Stat>& ParallelEnumerate::stats() const noexcept
+{
+	return stats_;
+}
+
+void ParallelEnumerate::run()
+{
+	const auto NB = Lobster::NO_BRANCH;
+	Lobster::Spine empty = { NB, NB, NB, NB, NB };
+
+	slots_.clear();
+	slots_.push_back({ { minSize_, empty }, false, false, false, {} });
+	taken_ = 0;
+	chainDone_ = false;
+	error_ = nullptr;
+
+	std::vector<std::thread> workers;
+	for (int i = 0; i < threads_; i++)
+		workers.emplace_back(&ParallelEnumerate::work, this);
+
+	std::size_t recorded = 0; // number of partitions written to the output
+
+	try {
+		std::unique_lock<std::mutex> lock(mutex_);
+
+		while (!error_) {
+			bool progress = false;
+
+			// hand out further partitions as soon as their predecessor's first result is known
+			while (!chainDone_ && slots_.back().leadKnown) {
+				if (!extendChain())
+					chainDone_ = true;
+
+				changed_.notify_all();
+				progress = true;
+			}
+
+			// record finished partitions in order
+			while (recorded < slots_.size() && slots_[recorded].done) {
+				std::vector<Stat> stats = std::move(slots_[recorded].stats);
+				recorded++;
+
+				lock.unlock();
+				record(stats);
+				lock.lock();
+				progress = true;
+			}
+
+			if (chainDone_ && recorded == slots_.size())
+				break;
+
+			// while recording, we may have missed signals from the workers
+			if (!progress)
+				changed_.wait(lock);
+		}
+	}
+	catch (...) {
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (!error_)
+			error_ = std::current_exception();
+		changed_.notify_all();
+	}
+
+	for (auto& worker : workers)
+		worker.join();
+
+	trace("Parallel benchmark evaluated {} partitions with {} threads.", slots_.size(), threads_);
+
+	if (error_)
+		std::rethrow_exception(error_);
+}
+
+Lobster ParallelEnumerate::firstLobster(const Partition& partition)
+{
+	const auto NB = Lobster::NO_BRANCH;
+	Lobster::Spine empty = { NB, NB, NB, NB, NB };
+	std::vector<Lobster::Spine> spine(partition.spines, empty);
+
+	if (!spine.empty())
+		spine[0] = partition.head;
+
+	return Lobster(std::move(spine));
+}
+
+bool ParallelEnumerate::contains(const Partition& partition, const Lobster& lobster) noexcept
+{
+	return lobster.countSpine() == partition.spines &&
+		(0 == partition.spines || lobster.spine()[0] == partition.head);
+}
+
+void ParallelEnumerate::work()
+{
+	WeakEmbedder fast;
+	DynamicProblemEmbedder reference(false);
+
+	try {
+		while (true) {
+			std::size_t index;
+			Partition partition;
+
+			{
+				std::unique_lock<std::mutex> lock(mutex_);
+				changed_.wait(lock, [this] { return error_ || taken_ < slots_.size() || chainDone_; });
+
+				if (error_ || taken_ == slots_.size())
+					return; // all done
+
+				index = taken_++;
+				partition = slots_[index].partition;
+			}
+
+			Enumerate enumerate(fast, reference, partition.spines, partition.spines + 1);
+			enumerate.setHeuristicBfsEnabled(heuristicBfsEnabled_);
+			enumerate.setHeuristicDfsEnabled(heuristicDfsEnabled_);
+			enumerate.setDynamicProgramEnabled(dynamicProgramEnabled_);
+			enumerate.setArchive(archive_);
+			enumerate.setCurrent(firstLobster(partition));
+
+			bool lead = true;
+
+			while (contains(partition, enumerate.current())) {
+				bool solved = enumerate.test().solved;
+
+				if (lead) {
+					std::lock_guard<std::mutex> lock(mutex_);
+					slots_[index].leadKnown = true;
+					slots_[index].leadSolved = solved;
+					changed_.notify_all();
+					lead = false;
+				}
+
+				enumerate.next();
+			}
+
+			std::lock_guard<std::mutex> lock(mutex_);
+			slots_[index].stats = enumerate.stats();
+			slots_[index].done = true;
+			changed_.notify_all();
+		}
+	}
+	catch (...) {
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (!error_)
+			error_ = std::current_exception();
+		changed_.notify_all();
+	}
+}
+
+bool ParallelEnumerate::extendChain()
+{
+	const Slot& last = slots_.back();
+	const auto NB = Lobster::NO_BRANCH;
+	Lobster::Spine empty = { NB, NB, NB, NB, NB };
+	Partition next{ last.partition.spines, empty };
+
+	// The first spine advances like a lobster of length 1. It only depends on
+	// whether the first lobster of the partition, with all other spines empty, was solved.
+	if (last.partition.spines > 0) {
+		Lobster head({ last.partition.head });
+		Enumerate::advance(head, last.leadSolved);
+
+		if (1 == head.countSpine())
+			next.head = head.spine()[0];
+		else
+			next.spines++;
+	}
+	else {
+		next.spines++;
+	}
+
+	if (next.spines >= maxSize_)
+		return false;
+
+	slots_.push_back({ next, false, false, false, {} });
+	return true;
+}
+
+void ParallelEnumerate::record(const std::vector<Stat>& stats)
+{
+	if (csv_) {
+		for (const Stat& stat : stats)
+			csv_->write(stat);
+	}
+	else {
+		stats_.insert(stats_.end(), stats.begin(), stats.end());
+	}
+}
@@ -0,0 +1,134 @@
+// Multi-threaded variant of the lobster enumeration benchmark
+
+#pragma once
+
+#include "enumerate.h"
+#include "output/csv.h"
+#include "output/archive.h"
+#include "utility/stat.h"
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+
+/**
+ * This enumerator evaluates the same sequence of lobster instances as @c Enumerate,
+ * but distributes the work over multiple worker threads.
+ *
+ * The enumeration is split into partitions. Every partition contains the lobsters of
+ * one spine length which share the same first spine configuration. Because the
+ * enumeration only ever changes the first spine when all following spines are empty,
+ * each partition begins at its first lobster and can be processed independently,
+ * including the skipping of extensions after a failed instance.
+ *
+ * The only sequential dependency is the chain of partitions itself: which first spine
+ * follows depends on whether the first lobster of the current partition was solved.
+ * The workers report this result early, so that the next partition can be handed out
+ * while the previous one is still running.
+ *
+ * Statistics are collected per partition and recorded in enumeration order, such that
+ * the output is identical to that of a single-threaded run.
+ */
+class ParallelEnumerate
+{
+
+public:
+
+	ParallelEnumerate(int minSize, int maxSize, int threads) noexcept;
+
+	/**
+	 * Set whether the heuristic with @c BREADTH_FIRST @c EmbedOrder is included in the benchmark.
+	 */
+	void setHeuristicBfsEnabled(bool enabled) noexcept;
+
+	/**
+	 * Set whether the heuristic with @c DEPTH_FIRST @c EmbedOrder is included in the benchmark.
+	 */
+	void setHeuristicDfsEnabled(bool enabled) noexcept;
+
+	/**
+	 * Set whether the dynamic programming approach is included in the benchmark.
+	 */
+	void setDynamicProgramEnabled(bool enabled) noexcept;
+
+	/**
+	 * @brief Configure the stats handler.
+	 *
+	 * If set, write a stat line for every evaluation result in enumeration order.
+	 * Otherwise, collect the statistics in memory.
+	 *
+	 * @param csv pointer to a stats handler or @c nullptr to disable
+	 */
+	void setCsv(Csv* csv) noexcept;
+
+	/**
+	 * @brief Configure the archive handler.
+	 *
+	 * If set, write a file in degree format for every evaluated instance.
+	 *
+	 * @param archive pointer to an archive handler or @c nullptr to disable
+	 */
+	void setArchive(Archive* archive) noexcept;
+
+	/**
+	 * Access statistics gathered.
+	 */
+	const std::vector<Stat>& stats() const noexcept;
+
+	/**
+	 * @brief Evaluate all instances with at least @c minSize spine vertices and
+	 * less than @c maxSize spine vertices.
+	 *
+	 * If any worker encounters an error, the remaining workers stop and the
+	 * exception is rethrown from this function.
+	 */
+	void run();
+
+	/**
+	 * @brief Return the lobster with which the given partition begins.
+	 */
+	static Lobster firstLobster(const Partition& partition);
+
+	/**
+	 * @brief Return true if the lobster is part of the given partition.
+	 */
+	static bool contains(const Partition& partition, const Lobster& lobster) noexcept;
+
+private:
+
+	/**
+	 * Progress of one partition in the enumeration.
+	 */
+	struct Slot
+	{
+		Partition partition;
+		bool leadKnown; //!< true when the first lobster of the partition has been evaluated
+		bool leadSolved; //!< evaluation result of the first lobster
+		bool done; //!< true when the partition has been completely evaluated
+		std::vector<Stat> stats; //!< results in enumeration order, until recorded
+	};
+
+	int minSize_;
+	int maxSize_;
+	int threads_;
+	bool heuristicBfsEnabled_;
+	bool heuristicDfsEnabled_;
+	bool dynamicProgramEnabled_;
+
+	Csv* csv_;
+	Archive* archive_;
+	std::vector<Stat> stats_;
+
+	std::mutex mutex_; // guards all members below
+	std::condition_variable changed_; // signals progress in any slot
+	std::deque<Slot> slots_; // partitions discovered so far in enumeration order
+	std::size_t taken_; // number of partitions handed out to workers
+	bool chainDone_; // true when all partitions have been discovered
+	std::exception_ptr error_; // first error that occurred in any worker
+
+	void work(); // worker thread main loop
+	bool extendChain(); // append the successor of the last partition, return false if none
+	void record(const std::vector<Stat>& stats);
+
+};
@@ -0,0 +1,593 @@
+#include "dynamic.h"
+#include "heuristic.h"
+#include "utility/grid.h"
+#include "utility/graph.h"
+#include "utility/log.h"
+#include "input/mapped.h"
+#include <random>
+#include <bitset>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <functional>
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <algorithm>
+#include <cstdlib>
+#include <unordered_map>
+
+/**
+ * Micro-benchmarks for the hot paths of the embedding algorithms.
+ *
+ * Every case compares the current implementation against a reference copy
+ * of the previous one, checks that both agree and reports their throughput.
+ */
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * Run the given function @c rounds times and return the elapsed seconds.
+ */
+double measure(int rounds, const std::function<void()>& function)
+{
+	auto start = Clock::now();
+
+	for (int i = 0; i < rounds; i++)
+		function();
+
+	std::chrono::duration<double> elapsed = Clock::now() - start;
+	return elapsed.count();
+}
+
+void report(const std::string& label, long long operations, double seconds)
+{
+	std::cout << "\t" << label << ": " << operations << " ops in " << seconds << " s ("
+		<< static_cast<long long>(operations / seconds) << " ops/s)\n";
+}
+
+/**
+ * Reference implementation of reachability which examines the fundament
+ * one coordinate at a time.
+ */
+namespace legacy
+{
+
+std::bitset<25> reachable(std::bitset<25> base, Coord from, int steps)
+{
+	std::bitset<25> result;
+	result.set(); // block everything
+	result.set(Fundament::index(from), false);
+
+	Coord near[] = { { -1, 0 }, { -1, 1 }, {0, 1}, {1, 0}, {1, -1}, {0, -1} };
+
+	for (int step = 0; step < steps; step++) {
+		std::bitset<25> mid = result;
+
+		for (int bit = 0; bit < 25; bit++) {
+			if (!result.test(bit)) {
+				Coord e = Fundament::at(bit);
+
+				for (Coord n : near) {
+					int next = Fundament::index({ e.x + n.x, e.sly + n.sly });
+					if (next != -1 && !base.test(next))
+						mid.set(next, false);
+				}
+			}
+		}
+
+		result = mid;
+	}
+
+	result.set(Fundament::index(from), true); // from is always blocked
+	return result;
+}
+
+std::bitset<25> reachableBySpine(std::bitset<25> base, Coord from)
+{
+	std::bitset<25> result;
+	result.set(); // block everything
+
+	Coord tos[] = { {from.x, from.sly + 1}, { from.x + 1, from.sly }, { from.x + 1, from.sly - 1 } };
+	for (Coord to : tos) {
+		int bit = Fundament::index(to);
+		if (bit >= 0 && !base.test(bit))
+			result.set(bit, false);
+	}
+
+	return result;
+}
+
+std::bitset<25> reachableEventually(std::bitset<25> base, Coord head, GraphTraversal position, GraphTraversal end)
+{
+	std::bitset<25> leafReach;
+	if (position != end && 2 == position->depth) {
+		leafReach = reachable(base, head, 1);
+
+		while (position != end && 2 <= position->depth)
+			++position;
+	}
+	else {
+		leafReach.set();
+	}
+
+	std::bitset<25> extReach;
+	extReach.set();
+
+	std::bitset<25> spinePlaces = 0x1ffefff;
+
+	while (position != end && !spinePlaces.all()) {
+		int reach = 0;
+		while (position != end && 0 != position->depth) {
+			if (position->depth > reach)
+				reach = position->depth;
+
+			++position;
+		}
+
+		for (int bit = 0; bit < 25; bit++) {
+			if (!spinePlaces.test(bit))
+				extReach &= reachable(base, Fundament::at(bit), reach);
+		}
+
+		std::bitset<25> nextSpinePlaces;
+		nextSpinePlaces.set();
+
+		for (int bit = 0; bit < 25; bit++) {
+			if (!spinePlaces.test(bit))
+				nextSpinePlaces &= reachableBySpine(base, Fundament::at(bit));
+		}
+
+		extReach &= nextSpinePlaces;
+		spinePlaces = nextSpinePlaces;
+
+		if (position != end)
+			++position;
+	}
+
+	return leafReach & extReach;
+}
+
+Signature signature(const DynamicProblem& problem)
+{
+	Coord head{ 0, 0 };
+	GraphTraversal position = problem.position();
+
+	if (position != GraphTraversal{} && 2 == position->depth) {
+		Coord branchHead = problem.branchHead();
+		Coord spineHead = problem.spineHead();
+		head = { branchHead.x - spineHead.x, branchHead.sly - spineHead.sly };
+	}
+
+	std::bitset<25> fundament = reachableEventually(problem.fundament().mask, head, position, {});
+	std::bitset<25> mirrored = fundament;
+
+	for (int x = 0; x < 4; x++) {
+		for (int y = 0; y < 4 - x; y++) {
+			int upper = 5 + x * 6 + y * 5;
+			int lower = 1 + x * 6 + y;
+
+			bool temp = mirrored[upper];
+			mirrored[upper] = mirrored[lower];
+			mirrored[lower] = temp;
+		}
+	}
+
+	if (mirrored.to_ulong() < fundament.to_ulong()) {
+		fundament = mirrored;
+		head.x += head.sly;
+		head.sly = -head.sly;
+	}
+
+	Fundament result;
+	result.mask = fundament.to_ulong();
+	return Signature{ problem.depth(), result, head };
+}
+
+/**
+ * Reference implementation of the grid based on a node-based hash map.
+ */
+class Grid
+{
+
+public:
+
+	explicit Grid(std::size_t size) : map_(size, coordHash) {}
+
+	Disk* at(Coord coord) const
+	{
+		auto it = map_.find(coord);
+		return map_.end() == it ? nullptr : it->second;
+	}
+
+	void put(Coord coord, Disk& disk)
+	{
+		map_.insert({ coord, &disk });
+	}
+
+private:
+
+	static std::size_t coordHash(Coord coord) noexcept
+	{
+		return (coord.sly << 16) + coord.x;
+	}
+
+	std::unordered_map<Coord, Disk*, decltype(&coordHash)> map_;
+
+};
+
+}
+
+/**
+ * Generate a random lobster with the given number of spines.
+ */
+Lobster randomLobster(std::mt19937& random, int spines)
+{
+	std::uniform_int_distribution<int> branches(0, 4);
+	std::uniform_int_distribution<int> leaves(0, 4);
+	std::vector<Lobster::Spine> spine;
+
+	for (int i = 0; i < spines; i++) {
+		Lobster::Spine s = { Lobster::NO_BRANCH, Lobster::NO_BRANCH, Lobster::NO_BRANCH, Lobster::NO_BRANCH, Lobster::NO_BRANCH };
+		int count = branches(random);
+		for (int j = 0; j < count; j++)
+			s[j] = leaves(random);
+		spine.push_back(s);
+	}
+
+	return Lobster(move(spine));
+}
+
+/**
+ * Generate a random caterpillar with the given number of spines,
+ * represented as a lobster with empty branches (leaves of the caterpillar).
+ */
+Lobster randomCaterpillar(std::mt19937& random, int spines)
+{
+	std::uniform_int_distribution<int> branches(0, 2); // mostly embeddable
+	std::vector<Lobster::Spine> spine;
+
+	for (int i = 0; i < spines; i++) {
+		Lobster::Spine s = { Lobster::NO_BRANCH, Lobster::NO_BRANCH, Lobster::NO_BRANCH, Lobster::NO_BRANCH, Lobster::NO_BRANCH };
+		int count = branches(random);
+		for (int j = 0; j < count; j++)
+			s[j] = 0;
+		spine.push_back(s);
+	}
+
+	return Lobster(move(spine));
+}
+
+/**
+ * One input to the reachability function.
+ */
+struct ReachInput
+{
+	Fundament base;
+	Coord head;
+	GraphTraversal position;
+};
+
+/**
+ * Compare the throughput of reachability computations, which dominate the
+ * computation of problem signatures in the dynamic program.
+ */
+bool reachability()
+{
+	std::cout << "Reachability (signature)\n";
+
+	std::mt19937 random(42);
+	std::uniform_int_distribution<std::uint32_t> masks(0, Fundament::ALL);
+	std::uniform_int_distribution<int> dirs(0, 5);
+	Dir near[] = { Dir::LEFT, Dir::LEFT_UP, Dir::LEFT_DOWN, Dir::RIGHT, Dir::RIGHT_UP, Dir::RIGHT_DOWN };
+
+	std::vector<DiskGraph> graphs;
+	for (int i = 0; i < 20; i++)
+		graphs.push_back(DiskGraph::fromLobster(randomLobster(random, 6)));
+
+	std::vector<ReachInput> inputs;
+	for (DiskGraph& graph : graphs) {
+		for (auto it = graph.traversal(Configuration::EmbedOrder::DEPTH_FIRST); it != graph.end(); ++it) {
+			Fundament base;
+			base.mask = masks(random) & masks(random); // about one in four blocked
+			base.block({ 0, 0 });
+			Coord head = Coord{ 0, 0 } + near[dirs(random)];
+			inputs.push_back({ base, head, it });
+		}
+	}
+
+	for (const ReachInput& in : inputs) {
+		Fundament actual = reachableEventually(in.base, in.head, in.position, {});
+		std::bitset<25> expected = legacy::reachableEventually(in.base.mask, in.head, in.position, {});
+
+		if (actual.mask != expected.to_ulong()) {
+			std::cout << "\tMISMATCH: " << std::bitset<25>(actual.mask) << " != " << expected << "\n";
+			return false;
+		}
+	}
+
+	const int rounds = 200;
+	std::uint32_t sink = 0; // defeat optimization
+
+	double legacyTime = measure(rounds, [&inputs, &sink] {
+		for (const ReachInput& in : inputs)
+			sink ^= legacy::reachableEventually(in.base.mask, in.head, in.position, {}).to_ulong();
+	});
+
+	double currentTime = measure(rounds, [&inputs, &sink] {
+		for (const ReachInput& in : inputs)
+			sink ^= reachableEventually(in.base, in.head, in.position, {}).mask;
+	});
+
+	long long operations = static_cast<long long>(rounds) * inputs.size();
+	report("legacy", operations, legacyTime);
+	report("current", operations, currentTime);
+	std::cout << "\tspeedup: " << legacyTime / currentTime << " (" << sink % 2 << ")\n";
+	return true;
+}
+
+/**
+ * Compare the throughput of signature computation for sibling problems,
+ * one by one and in batches.
+ */
+bool signature()
+{
+	std::cout << "Signature\n";
+
+	std::mt19937 random(42);
+	std::vector<DiskGraph> graphs;
+	for (int i = 0; i < 20; i++)
+		graphs.push_back(DiskGraph::fromLobster(randomLobster(random, 6)));
+
+	// collect groups of siblings from a breadth-first expansion without deduplication
+	std::vector<std::vector<DynamicProblem>> groups;
+	for (DiskGraph& graph : graphs) {
+		std::vector<DynamicProblem> open{ DynamicProblem(graph) };
+
+		for (std::size_t i = 0; i < open.size() && open.size() < 2000; i++) {
+			if (open[i].depth() == static_cast<int>(graph.size()))
+				continue;
+
+			auto subproblems = open[i].subproblems();
+			open.insert(open.end(), subproblems.begin(), subproblems.end());
+			if (!subproblems.empty())
+				groups.push_back(move(subproblems));
+		}
+	}
+
+	std::size_t problems = 0;
+	for (const auto& group : groups) {
+		auto batch = DynamicProblem::signatures(group);
+
+		for (std::size_t i = 0; i < group.size(); i++) {
+			Signature expected = legacy::signature(group[i]);
+
+			if (!(group[i].signature() == expected) || !(batch[i] == expected)) {
+				std::cout << "\tMISMATCH at depth " << expected.depth << "\n";
+				return false;
+			}
+		}
+
+		problems += group.size();
+	}
+
+	const int rounds = 20;
+	int sink = 0; // defeat optimization
+
+	double legacyTime = measure(rounds, [&groups, &sink] {
+		for (const auto& group : groups)
+			for (const DynamicProblem& problem : group)
+				sink ^= legacy::signature(problem).fundament.mask;
+	});
+
+	double singleTime = measure(rounds, [&groups, &sink] {
+		for (const auto& group : groups)
+			for (const DynamicProblem& problem : group)
+				sink ^= problem.signature().fundament.mask;
+	});
+
+	double batchTime = measure(rounds, [&groups, &sink] {
+		for (const auto& group : groups)
+			for (const Signature& signature : DynamicProblem::signatures(group))
+				sink ^= signature.fundament.mask;
+	});
+
+	long long operations = static_cast<long long>(rounds) * problems;
+	report("legacy", operations, legacyTime);
+	report("single", operations, singleTime);
+	report("batch", operations, batchTime);
+	std::cout << "\tspeedup: " << legacyTime / batchTime << " (" << sink % 2 << ")\n";
+	return true;
+}
+
+/**
+ * Replay the placements of an embedding on the grid with the neighborhood
+ * queries which the heuristic performs around every placed disk.
+ */
+template<class G>
+int replay(const std::vector<Coord>& placements, std::vector<Disk>& disks)
+{
+	G grid(placements.size());
+	int occupied = 0;
+
+	for (std::size_t i = 0; i < placements.size(); i++) {
+		for (Coord c : neighbors(placements[i]))
+			occupied += nullptr != grid.at(c);
+		for (Coord c : neighbors2(placements[i]))
+			occupied += nullptr != grid.at(c);
+
+		grid.put(placements[i], disks[i]);
+	}
+
+	return occupied;
+}
+
+/**
+ * Measure the throughput of the grid heuristic on long caterpillars and
+ * compare the grid implementations under its access pattern.
+ */
+bool grid()
+{
+	std::cout << "Grid (heuristic on 1000-spine caterpillars)\n";
+
+	std::mt19937 random(42);
+	std::vector<DiskGraph> graphs;
+	for (int i = 0; i < 10; i++)
+		graphs.push_back(DiskGraph::fromLobster(randomCaterpillar(random, 1000)));
+
+	WeakEmbedder embedder;
+	long long disks = 0;
+	const int rounds = 10;
+
+	double heuristicTime = measure(rounds, [&graphs, &embedder, &disks] {
+		for (const DiskGraph& graph : graphs) {
+			DiskGraph copy = graph;
+			embed(copy, embedder, Configuration::Algorithm::CLEVE, Configuration::EmbedOrder::DEPTH_FIRST);
+			disks += copy.size();
+		}
+	});
+
+	report("heuristic (disks)", disks, heuristicTime);
+
+	// collect distinct placements from the embeddings
+	std::vector<Coord> placements;
+	for (const DiskGraph& graph : graphs) {
+		DiskGraph copy = graph;
+		embed(copy, embedder, Configuration::Algorithm::CLEVE, Configuration::EmbedOrder::DEPTH_FIRST);
+		::Grid seen(copy.size());
+
+		for (Disk& disk : copy.disks()) {
+			Coord c{ disk.grid_x, disk.grid_sly };
+			if (!disk.failure && !seen.at(c)) {
+				seen.put(c, disk);
+				placements.push_back(c);
+			}
+		}
+	}
+
+	std::vector<Disk> dummies(placements.size());
+	int expected = replay<legacy::Grid>(placements, dummies);
+	int actual = replay<::Grid>(placements, dummies);
+
+	if (expected != actual) {
+		std::cout << "\tMISMATCH: " << actual << " != " << expected << "\n";
+		return false;
+	}
+
+	int sink = 0; // defeat optimization
+	double legacyTime = measure(rounds, [&] { sink ^= replay<legacy::Grid>(placements, dummies); });
+	double currentTime = measure(rounds, [&] { sink ^= replay<::Grid>(placements, dummies); });
+
+	long long operations = static_cast<long long>(rounds) * placements.size() * 19;
+	report("legacy probes", operations, legacyTime);
+	report("current probes", operations, currentTime);
+	std::cout << "\tspeedup: " << legacyTime / currentTime << " (" << sink % 2 << ")\n";
+	return true;
+}
+
+/**
+ * Measure the throughput of the edge list parsers on a large lobster-sized input
+ * and compare the stream reader against the memory-mapped readers.
+ */
+bool parse()
+{
+	std::cout << "Parse (edge list of 500000 vertices)\n";
+
+	// random caterpillar-like tree: a spine with leaves hanging off random spine vertices
+	std::mt19937 random(42);
+	const int vertices = 500000;
+	EdgeList edges;
+	for (int v = 1; v < vertices; v++) {
+		std::uniform_int_distribution<int> parent(std::max(0, v - 8), v - 1);
+		edges.push_back({ v, parent(random) });
+	}
+
+	const auto directory = std::filesystem::temp_directory_path();
+	const auto textFile = directory / "udcr_perftest_edges.txt";
+	const auto binaryFile = directory / "udcr_perftest_edges.bin";
+
+	{
+		std::ofstream text{ textFile };
+		edges_to_text(text, edges);
+		std::ofstream binary{ binaryFile, std::ios::binary };
+		edges_to_binary(binary, edges);
+	}
+
+	auto same = [&edges](const EdgeList& parsed) {
+		return std::equal(edges.begin(), edges.end(), parsed.begin(), parsed.end(),
+			[](Edge e, Edge f) { return e.from == f.from && e.to == f.to; });
+	};
+
+	bool success = true;
+	std::size_t sink = 0; // defeat optimization
+	const int rounds = 5;
+
+	double streamTime = measure(rounds, [&] {
+		std::ifstream stream{ textFile };
+		EdgeList parsed = edges_from_text(stream);
+		success = success && same(parsed);
+		sink += parsed.size();
+	});
+
+	double mappedTime = measure(rounds, [&] {
+		MappedFile file{ textFile };
+		EdgeList parsed = edges_from_text(file.view());
+		success = success && same(parsed);
+		sink += parsed.size();
+	});
+
+	double binaryTime = measure(rounds, [&] {
+		MappedFile file{ binaryFile };
+		EdgeList parsed = edges_from_binary(file.view());
+		success = success && same(parsed);
+		sink += parsed.size();
+	});
+
+	std::filesystem::remove(textFile);
+	std::filesystem::remove(binaryFile);
+
+	if (!success) {
+		std::cout << "\tMISMATCH in parsed edges\n";
+		return false;
+	}
+
+	long long operations = static_cast<long long>(rounds) * edges.size();
+	report("legacy stream (edges)", operations, streamTime);
+	report("mapped text (edges)", operations, mappedTime);
+	report("mapped binary (edges)", operations, binaryTime);
+	std::cout << "\tspeedup: " << streamTime / mappedTime << " text, " << streamTime / binaryTime << " binary (" << sink % 2 << ")\n";
+	return true;
+}
+
+}
+
+/**
+ * Run all performance test cases, or only the ones named on the command line.
+ */
+int main(int argc, const char* argv[])
+{
+	theLog->setLevel(Configuration::LogLevel::ERROR);
+
+	struct Case { std::string name; bool (*run)(); };
+	std::vector<Case> cases = {
+		{ "reachability", &reachability },
+		{ "signature", &signature },
+		{ "grid", &grid },
+		{ "parse", &parse }
+	};
+
+	bool success = true;
+
+	for (const Case& c : cases) {
+		bool selected = argc < 2;
+		for (int i = 1; i < argc; i++)
+			selected = selected || c.name == argv[i];
+
+		if (selected)
+			success = c.run() && success;
+	}
+
+	return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -4,6 +4,7 @@
 #include <algorithm>
 #include <unordered_map>
 #include <string>
+#include <cstdint>
 #include <cstring>
 #include <cassert>
 #include <numeric>
@@ -142,6 +143,70 @@ EdgeList edges_from_text(std::istream& stream)
 	return edges;
 }
 
+EdgeList edges_from_text(std::string_view text)
+{
+	std::vector<Edge> edges;
+	edges.reserve(text.size() / 8); // rough estimate of the line length
+
+	// read all edges from input text
+	DiskId from, to;
+
+	while (readint(text, from) && readint(text, to)) {
+		Edge e{ from, to };
+		edges.push_back(e);
+		ignoreline(text);
+	}
+
+	return edges;
+}
+
+namespace
+{
+
+constexpr std::size_t BINARY_ID_SIZE = 4; // bytes per vertex id in binary format
+
+std::int32_t read_binary_id(const char* data) noexcept
+{
+	const auto* bytes = reinterpret_cast<const unsigned char*>(data);
+	const std::uint32_t value = std::uint32_t{ bytes[0] } | std::uint32_t{ bytes[1] } << 8 |
+		std::uint32_t{ bytes[2] } << 16 | std::uint32_t{ bytes[3] } << 24;
+	return static_cast<std::int32_t>(value);
+}
+
+void write_binary_id(char* data, std::int32_t id) noexcept
+{
+	const auto value = static_cast<std::uint32_t>(id);
+	for (std::size_t i = 0; i < BINARY_ID_SIZE; i++)
+		data[i] = static_cast<char>(value >> (8 * i) & 0xff);
+}
+
+}
+
+EdgeList edges_from_binary(std::string_view data)
+{
+	const std::size_t edgeSize = 2 * BINARY_ID_SIZE;
+
+	if (data.size() % edgeSize != 0) {
+		throw InputException("Binary edge list size {} is not a multiple of {}.", data.size(), edgeSize);
+	}
+
+	std::vector<Edge> edges(data.size() / edgeSize);
+
+	for (std::size_t i = 0; i < edges.size(); i++) {
+		const char* record = data.data() + i * edgeSize;
+		const DiskId from = read_binary_id(record);
+		const DiskId to = read_binary_id(record + BINARY_ID_SIZE);
+
+		if (from < 0 || to < 0) {
+			throw InputException("Read value {} is less than min value {}.", std::min(from, to), 0);
+		}
+
+		edges[i] = { from, to };
+	}
+
+	return edges;
+}
+
 void edges_to_text(std::ostream& stream, const EdgeList& edges)
 {
 	for (const auto& edge : edges) {
@@ -152,6 +217,20 @@ void edges_to_text(std::ostream& stream, const EdgeList& edges)
 		throw OutputException(std::strerror(errno));
 }
 
+void edges_to_binary(std::ostream& stream, const EdgeList& edges)
+{
+	char record[2 * BINARY_ID_SIZE];
+
+	for (const auto& edge : edges) {
+		write_binary_id(record, edge.from);
+		write_binary_id(record + BINARY_ID_SIZE, edge.to);
+		stream.write(record, sizeof record);
+	}
+
+	if (stream.fail())
+		throw OutputException(std::strerror(errno));
+}
+
 EdgeList::iterator separate_leaves(EdgeList::iterator begin, EdgeList::iterator end)
 {
 	const std::size_t es = end - begin; // nr of edges
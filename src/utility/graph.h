@@ -4,6 +4,7 @@
 
 #include <array>
 #include <vector>
+#include <string_view>
 #include "geometry.h"
 #include "config.h" // TODO: refactor
 
@@ -137,11 +138,34 @@ using EdgeList = std::vector<Edge>;
  */
 EdgeList edges_from_text(std::istream& stream);
 
+/**
+ * Parse a text representation of an edge list from the given text in memory.
+ *
+ * The format and error reporting are the same as for the stream version,
+ * but the numbers are converted directly from the character buffer.
+ */
+EdgeList edges_from_text(std::string_view text);
+
+/**
+ * Parse a binary representation of an edge list.
+ *
+ * We expect a sequence of edges, each given as the 32-bit little-endian
+ * signed integer id of the from-vertex followed by that of the to-vertex.
+ */
+EdgeList edges_from_binary(std::string_view data);
+
 /**
  * Write a text representation of an edge list to the given stream.
  */
 void edges_to_text(std::ostream& stream, const EdgeList& edges);
 
+/**
+ * Write a binary representation of an edge list to the given stream.
+ *
+ * @see edges_from_binary
+ */
+void edges_to_binary(std::ostream& stream, const EdgeList& edges);
+
 /**
  * Reorder the edge list from begin to end.
  * Move edges which connect leaves to the back and others to the front.
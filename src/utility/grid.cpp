@@ -3,40 +3,76 @@
 #include <cassert>
 
 Grid::Grid(std::size_t size)
-	: map_(size, coordHash)
+	: slots_(), bits_(0), size_(0)
 {
-
+	reserve(size);
 }
 
 Disk* Grid::at(Coord coord) const
 {
-	auto it = map_.find(coord);
-
-	if (map_.end() == it) {
-		return nullptr;
-	} else {
-		return it->second;
-	}
+	return slots_[find(coord)].disk;
 }
 
 void Grid::put(Coord coord, Disk& disk)
 {
-	auto it_inserted = map_.insert({ coord, &disk });
-	assert(it_inserted.second);
+	reserve(size_ + 1);
+
+	Slot& slot = slots_[find(coord)];
+	assert(!slot.disk);
+	slot = { coord, &disk };
+	size_++;
 }
 
-std::size_t Grid::coordHash(Coord coord) noexcept
+std::size_t Grid::coordHash(Coord coord) const noexcept
 {
-	return (coord.sly << 16) + coord.x;
+	// Fibonacci hashing of both components packed into one word
+	std::uint64_t key = static_cast<std::uint64_t>(static_cast<std::uint32_t>(coord.sly)) << 32 |
+		static_cast<std::uint32_t>(coord.x);
+	return static_cast<std::size_t>((key * 0x9e3779b97f4a7c15ull) >> (64 - bits_));
+}
+
+std::size_t Grid::find(Coord coord) const noexcept
+{
+	const std::size_t mask = slots_.size() - 1;
+	std::size_t i = coordHash(coord);
+
+	while (slots_[i].disk && !(slots_[i].coord == coord))
+		i = (i + 1) & mask;
+
+	return i;
+}
+
+void Grid::reserve(std::size_t size)
+{
+	// keep the load factor at or below 1/2
+	if (2 * size <= slots_.size())
+		return;
+
+	int bits = 3;
+	while ((std::size_t{ 1 } << bits) < 2 * size)
+		bits++;
+
+	std::vector<Slot> old(std::size_t{ 1 } << bits, Slot{ {0, 0}, nullptr });
+	old.swap(slots_);
+	bits_ = bits;
+
+	for (const Slot& slot : old) {
+		if (slot.disk)
+			slots_[find(slot.coord)] = slot;
+	}
 }
 
 void Grid::apply() const noexcept
 {
-	for (auto const& [coord, disk] : map_)
+	for (const Slot& slot : slots_)
 	{
-		disk->grid_x = coord.x;
-		disk->grid_sly = coord.sly;
-		Vec2 diskVec = vec(coord);
+		if (!slot.disk)
+			continue;
+
+		Disk* disk = slot.disk;
+		disk->grid_x = slot.coord.x;
+		disk->grid_sly = slot.coord.sly;
+		Vec2 diskVec = vec(slot.coord);
 		disk->x = diskVec.x;
 		disk->y = diskVec.y;
 		disk->embedded = true;
@@ -45,5 +81,5 @@ void Grid::apply() const noexcept
 
 std::size_t Grid::size() const noexcept
 {
-	return map_.size();
+	return size_;
 }
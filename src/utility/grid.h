@@ -4,11 +4,15 @@
 
 #include "geometry.h"
 #include <vector>
-#include <unordered_map>
+#include <cstdint>
 
 /**
  * This triangular grid is used for the weak contact lobster embedding.
  * The grid stores integers, which are used for disk IDs.
+ *
+ * Entries are kept in a flat open-addressing hash table with linear probing,
+ * so that the frequent neighborhood queries of the heuristics touch only
+ * a few adjacent slots in memory.
  */
 class Grid
 {
@@ -45,7 +49,24 @@ public:
 
 private:
 
-	static std::size_t coordHash(Coord coord) noexcept;
-	std::unordered_map<Coord, Disk*, decltype(&coordHash)> map_;
+	struct Slot
+	{
+		Coord coord;
+		Disk* disk; //!< @c nullptr if the slot is empty
+	};
+
+	std::vector<Slot> slots_; // capacity is a power of two
+	int bits_; // log2 of capacity
+	std::size_t size_; // number of occupied slots
+
+	std::size_t coordHash(Coord coord) const noexcept;
+
+	/**
+	 * Return the index of the slot which holds @c coord, or of the empty
+	 * slot where it belongs.
+	 */
+	std::size_t find(Coord coord) const noexcept;
+
+	void reserve(std::size_t size); // ensure capacity for the given number of entries
 
 };
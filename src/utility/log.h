@@ -13,6 +13,7 @@
 #include <streambuf>
 #include <ostream>
 #include <filesystem>
+#include <mutex>
 
 /**
  * The log can accept messages as strings, add a timestamp, and write it to
@@ -31,8 +32,10 @@ public:
      */
     void write(Configuration::LogLevel level, const std::string& fmt, auto&&... args) noexcept
     {
-        if (level_ <= level)
+        if (level_ <= level) {
+            std::lock_guard<std::mutex> lock(mutex_);
             writeImpl(tag(level) + format(fmt, args...) + "\n");
+        }
     }
 
     /**
@@ -40,8 +43,10 @@ public:
      */
     Log& writeRaw(Configuration::LogLevel level, const std::string& fmt, auto&&... args) noexcept
     {
-        if (level_ <= level)
+        if (level_ <= level) {
+            std::lock_guard<std::mutex> lock(mutex_);
             writeImpl(format(fmt, args...));
+        }
 
         return *this;
     }
@@ -68,6 +73,7 @@ private:
     std::string tag(Configuration::LogLevel level) const noexcept;
 
     Configuration::LogLevel level_;
+    std::mutex mutex_; // serializes messages from concurrent threads
 
 };
 
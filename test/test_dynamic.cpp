@@ -116,7 +116,7 @@ TEST(Dynamic, fundament_reachable)
 	//    x x
 	//     x
 	unsigned long expectedReachable = 0x1e77ff;
-	EXPECT_EQ(expectedReachable, reachable.mask.to_ulong());
+	EXPECT_EQ(expectedReachable, reachable.mask);
 
 	reachable = fundament.reachableBySpine(from);
 
@@ -130,7 +130,7 @@ TEST(Dynamic, fundament_reachable)
 	//    x x
 	//     x
 	expectedReachable = 0x13fffff;
-	EXPECT_EQ(expectedReachable, reachable.mask.to_ulong());
+	EXPECT_EQ(expectedReachable, reachable.mask);
 }
 
 /**
@@ -212,7 +212,8 @@ TEST(Dynamic, subproblem)
 	
 	Fundament fundament(solution, { 0, 0 });
 	DiskGraph graph(move(disks));
-	DynamicProblem problem(graph);
+	SolutionTree tree(graph);
+	DynamicProblem problem(graph, &tree);
 	GraphTraversal position(&graph.disks()[5], Configuration::EmbedOrder::DEPTH_FIRST);
 	problem.setState(fundament, position, { 0, 0 }, { 1, -1 }, 5);
 	EXPECT_EQ(problem.depth(), 5);
@@ -229,6 +230,9 @@ TEST(Dynamic, subproblem)
 	EXPECT_EQ(result[1].solution().at(expectedCoord), &graph.disks()[5]);
 	EXPECT_EQ(result[1].spineHead(), expectedCoord);
 	EXPECT_EQ(result[1].depth(), 6);
+
+	// both placements are recorded in the shared tree
+	EXPECT_EQ(tree.size(), 2);
 }
 
 TEST(Dynamic, reachableEventually)
@@ -283,7 +287,7 @@ TEST(Dynamic, reachableEventually)
 	//    - -
 	//     -
 	unsigned long expected = 0x1394e3;
-	EXPECT_EQ(actual.mask.to_ulong(), expected);
+	EXPECT_EQ(actual.mask, expected);
 }
 
 /**
@@ -449,3 +453,170 @@ TEST(Dynamic, embed_dynamic)
 	DynamicProblemEmbedder embedder;
 	EXPECT_TRUE(embedder.embed(graph));
 }
+
+/**
+ * Test that the closed set finds dominating signatures only within
+ * the same depth and head.
+ */
+TEST(Dynamic, closed_set)
+{
+	Fundament fun1;
+	fun1.mask = 0b00001'00011'01101'11111'11111;
+	Fundament fun2; // superset of fun1
+	fun2.mask = 0b00001'00011'11111'11111'11111;
+	Fundament fun3; // unrelated to fun1
+	fun3.mask = 0b00001'00011'00111'11111'11111;
+
+	ClosedSet closed(11);
+	closed.insert({ 10, fun1, {0, 0} });
+
+	EXPECT_TRUE(closed.dominated({ 10, fun1, {0, 0} }));
+	EXPECT_TRUE(closed.dominated({ 10, fun2, {0, 0} }));
+	EXPECT_FALSE(closed.dominated({ 10, fun3, {0, 0} }));
+	EXPECT_FALSE(closed.dominated({ 11, fun2, {0, 0} }));
+	EXPECT_FALSE(closed.dominated({ 10, fun2, {0, 1} }));
+
+	closed.insert({ 10, fun3, {0, 0} });
+	closed.insert({ 11, fun3, {0, 1} });
+	EXPECT_EQ(closed.size(10), 2);
+	EXPECT_EQ(closed.size(11), 1);
+	EXPECT_EQ(closed.size(0), 0);
+}
+
+/**
+ * Test that the precomputed neighbor masks agree with the coordinates.
+ */
+TEST(Dynamic, fundament_neighbors)
+{
+	Coord near[] = { { -1, 0 }, { -1, 1 }, {0, 1}, {1, 0}, {1, -1}, {0, -1} };
+	Coord forward[] = { {0, 1}, {1, 0}, {1, -1} };
+
+	for (int bit = 0; bit < 25; bit++) {
+		Coord c = Fundament::at(bit);
+		std::uint32_t neighbors = 0;
+		std::uint32_t spine = 0;
+
+		for (Coord n : near) {
+			int index = Fundament::index({ c.x + n.x, c.sly + n.sly });
+			if (index >= 0)
+				neighbors |= 1u << index;
+		}
+
+		for (Coord n : forward) {
+			int index = Fundament::index({ c.x + n.x, c.sly + n.sly });
+			if (index >= 0)
+				spine |= 1u << index;
+		}
+
+		EXPECT_EQ(Fundament::NEIGHBORS[bit], neighbors) << "bit " << bit;
+		EXPECT_EQ(Fundament::SPINE_NEIGHBORS[bit], spine) << "bit " << bit;
+	}
+
+	static_assert(Fundament::NEIGHBORS[12] == 0b00000'01100'01010'00110'00000);
+}
+
+/**
+ * Test that mirroring swaps every local coordinate (x,sly) with (x+sly,-sly).
+ */
+TEST(Dynamic, fundament_mirrored)
+{
+	for (int bit = 0; bit < 25; bit++) {
+		Coord c = Fundament::at(bit);
+		Fundament fundament;
+		fundament.block(c);
+
+		Fundament expected;
+		expected.block({ c.x + c.sly, -c.sly });
+
+		EXPECT_EQ(fundament.mirrored(), expected) << "bit " << bit;
+	}
+
+	Fundament fundament;
+	fundament.mask = 0b00001'00011'01101'11111'11111;
+	EXPECT_EQ(fundament.mirrored().mirrored(), fundament);
+}
+
+/**
+ * Test that the batch signatures of siblings equal their individual signatures.
+ */
+TEST(Dynamic, signatures)
+{
+	Lobster lobster({ { 2, 1, 0, Lobster::NO_BRANCH, Lobster::NO_BRANCH },
+		{ 3, Lobster::NO_BRANCH, Lobster::NO_BRANCH, Lobster::NO_BRANCH, Lobster::NO_BRANCH },
+		{ 1, 1, Lobster::NO_BRANCH, Lobster::NO_BRANCH, Lobster::NO_BRANCH } });
+	DiskGraph graph = DiskGraph::fromLobster(lobster);
+
+	std::vector<DynamicProblem> open{ DynamicProblem(graph) };
+	int groups = 0;
+
+	for (std::size_t i = 0; i < open.size() && open.size() < 500; i++) {
+		auto subproblems = open[i].subproblems();
+		auto signatures = DynamicProblem::signatures(subproblems);
+		ASSERT_EQ(signatures.size(), subproblems.size());
+
+		for (std::size_t j = 0; j < subproblems.size(); j++)
+			EXPECT_EQ(signatures[j], subproblems[j].signature());
+
+		open.insert(open.end(), subproblems.begin(), subproblems.end());
+		groups++;
+	}
+
+	EXPECT_GT(groups, 100);
+}
+
+/**
+ * Test that decision problems expand exactly like the constructive problems.
+ */
+TEST(Dynamic, decision_problem)
+{
+	const auto NB = Lobster::NO_BRANCH;
+	Lobster lobster({ { 2, 1, 0, NB, NB }, { 3, NB, NB, NB, NB }, { 1, 1, NB, NB, NB } });
+	DiskGraph graph = DiskGraph::fromLobster(lobster);
+	DepthSequence input(graph);
+	ASSERT_EQ(input.size(), graph.size());
+
+	SolutionTree tree(graph);
+	std::vector<DynamicProblem> dynamic{ DynamicProblem(graph, &tree) };
+	std::vector<DecisionProblem> decision{ DecisionProblem() };
+
+	for (std::size_t i = 0; i < dynamic.size() && dynamic.size() < 500; i++) {
+		auto expected = dynamic[i].subproblems();
+		std::vector<DecisionProblem> actual;
+		decision[i].subproblems(input, actual);
+		ASSERT_EQ(actual.size(), expected.size());
+
+		std::vector<Signature> signatures;
+		DecisionProblem::signatures(actual, input, signatures);
+
+		for (std::size_t j = 0; j < expected.size(); j++) {
+			EXPECT_EQ(actual[j].depth(), expected[j].depth());
+			EXPECT_EQ(actual[j].signature(input), expected[j].signature());
+			EXPECT_EQ(signatures[j], expected[j].signature());
+		}
+
+		dynamic.insert(dynamic.end(), expected.begin(), expected.end());
+		decision.insert(decision.end(), actual.begin(), actual.end());
+	}
+}
+
+/**
+ * Test that deciding and constructing agree on instances with and without embedding.
+ */
+TEST(Dynamic, embed_decide)
+{
+	const auto NB = Lobster::NO_BRANCH;
+	Lobster yes({ {2, 2, 2, 1, 1}, {2, 2, 2, NB, NB} });
+	Lobster no({ {4, 4, 4, 4, 4}, {4, 4, 4, 4, 4} });
+
+	for (const Lobster* lobster : { &yes, &no }) {
+		DiskGraph constructGraph = DiskGraph::fromLobster(*lobster);
+		DiskGraph decideGraph = DiskGraph::fromLobster(*lobster);
+		DynamicProblemEmbedder construct(true);
+		DynamicProblemEmbedder decide(false);
+
+		EXPECT_EQ(decide.embed(decideGraph), construct.embed(constructGraph));
+	}
+
+	DiskGraph graph = DiskGraph::fromLobster(no);
+	EXPECT_FALSE(DynamicProblemEmbedder(false).embed(graph));
+}
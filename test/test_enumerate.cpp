@@ -2,6 +2,7 @@
 
 #include "gtest/gtest.h"
 #include "enumerate.h"
+#include "parallel.h"
 #include "heuristic.h"
 #include <memory>
 
@@ -85,3 +86,28 @@ TEST(Enumerate, nextCanonical)
 	enumerate.next();
 	EXPECT_EQ(enumerate.current(), Lobster({ {3, 2, 1, 0, 0}, {NB, NB, NB, NB, NB} }));
 }
+
+/**
+ * Test that the multi-threaded enumeration produces the same statistics as the sequential one.
+ */
+TEST(Enumerate, parallel)
+{
+	WeakEmbedder fast;
+	DynamicProblemEmbedder reference(false);
+	Enumerate sequential(fast, reference, 1, 3);
+	sequential.run();
+
+	ParallelEnumerate parallel(1, 3, 3);
+	parallel.run();
+
+	const auto& expected = sequential.stats();
+	const auto& actual = parallel.stats();
+	ASSERT_EQ(expected.size(), actual.size());
+
+	for (std::size_t i = 0; i < expected.size(); i++) {
+		EXPECT_EQ(expected[i].identifier, actual[i].identifier);
+		EXPECT_EQ(expected[i].algorithm, actual[i].algorithm);
+		EXPECT_EQ(expected[i].embedOrder, actual[i].embedOrder);
+		EXPECT_EQ(expected[i].success, actual[i].success);
+	}
+}
@@ -2,6 +2,9 @@
 
 #include "gtest/gtest.h"
 #include "utility/graph.h"
+#include "utility/exception.h"
+#include <sstream>
+#include <algorithm>
 
 namespace
 {
@@ -56,6 +59,48 @@ bool edges_equal(Edge e, Edge f)
 	return e.from == f.from && e.to == f.to;
 }
 
+/**
+ * Ensure that the in-memory text parser agrees with the stream parser and reports the same errors.
+ */
+TEST(Graph, edges_from_text_view)
+{
+	const std::string input =
+		"5 3\n"
+		"6 3\r\n"
+		"\n"
+		"  9\t3  \n"
+		"11 8";
+	std::istringstream stream{ input };
+	const auto expected = edges_from_text(stream);
+	const auto result = edges_from_text(std::string_view{ input });
+	ASSERT_EQ(4, result.size()) << "expected 4 edges, but actually " << result.size();
+	EXPECT_TRUE(std::equal(expected.begin(), expected.end(), result.begin(), result.end(), edges_equal));
+
+	EXPECT_THROW(edges_from_text(std::string_view{ "5 x\n" }), InputException);
+	EXPECT_THROW(edges_from_text(std::string_view{ "5 -3\n" }), InputException);
+	EXPECT_THROW(edges_from_text(std::string_view{ "5 3 4\n" }), InputException);
+	EXPECT_THROW(edges_from_text(std::string_view{ "5 99999999999\n" }), InputException);
+}
+
+/**
+ * Ensure that edge lists survive the round trip through the binary format.
+ */
+TEST(Graph, edges_binary)
+{
+	const EdgeList edges = { { 5, 3 }, { 6, 3 }, { 70000, 3 }, { 0x12345678, 6 } };
+	std::ostringstream stream;
+	edges_to_binary(stream, edges);
+	const std::string data = stream.str();
+	ASSERT_EQ(edges.size() * 8, data.size());
+	EXPECT_EQ(5, data[0]) << "expected little-endian ids";
+
+	const auto result = edges_from_binary(data);
+	EXPECT_TRUE(std::equal(edges.begin(), edges.end(), result.begin(), result.end(), edges_equal));
+
+	EXPECT_THROW(edges_from_binary(std::string_view{ data }.substr(1)), InputException);
+	EXPECT_THROW(edges_from_binary(std::string_view{ "\xff\xff\xff\xff\0\0\0\0", 8 }), InputException);
+}
+
 TEST(Graph, separate_leaves)
 {
 	EdgeList graph{ {3, 5}, {4, 3}, {7, 4} };
@@ -30,3 +30,23 @@ TEST(Grid, Grid_access)
 		}
 	}
 }
+
+/**
+ * Store more disks than initially reserved, including far-away coordinates.
+ */
+TEST(Grid, Grid_grow)
+{
+	const int count = 100;
+	Disk disks[count];
+	Grid grid(1);
+
+	for (int i = 0; i < count; i++)
+		grid.put({ i * 1000 - 50000, -i }, disks[i]);
+
+	EXPECT_EQ(grid.size(), count);
+
+	for (int i = 0; i < count; i++) {
+		EXPECT_EQ(grid.at({ i * 1000 - 50000, -i }), &disks[i]);
+		EXPECT_EQ(grid.at({ i * 1000 - 50000, i + 1 }), nullptr);
+	}
+}